@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file convertLog.cpp
+    \brief This file is a testing binary for converting a log file of Velodyne
+           data packets to or from the compressed log format.
+  */
+
+#include <cstdlib>
+
+#include <iostream>
+
+#include "sensor/PacketLogReader.h"
+#include "sensor/PacketLogger.h"
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " <LogFile> <OutputLogFile> "
+      "<Compress>" << std::endl;
+    return -1;
+  }
+  PacketLogReader logReader(argv[1]);
+  const bool compress = atoi(argv[3]);
+  PacketLogger logger(argv[2], 2048, 8, false, 0, 0.0, 1.0, compress);
+  logger.start();
+  for (size_t i = 0; i < logReader.getNumPackets(); ++i)
+    while (!logger.log(logReader.getPacket(i)))
+      logger.flush();
+  logger.interrupt();
+  std::cout << logger.getNumWritten() << " packets, "
+    << logReader.getFileSize() << " bytes read" << std::endl;
+  return logger.getNumFailed() ? -1 : 0;
+}
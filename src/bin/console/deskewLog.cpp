@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file deskewLog.cpp
+    \brief This file is a testing binary for assembling the revolutions of a
+           log file of Velodyne data packets, deskewed with a pose file, into
+           point clouds in bulk binary format.
+  */
+
+#include <iostream>
+#include <fstream>
+#include <limits>
+
+#include "sensor/Calibration.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/PoseInterpolator.h"
+#include "sensor/RevolutionAssembler.h"
+#include "data-structures/Pose.h"
+#include "data-structures/VdynePointCloud.h"
+
+int main(int argc, char **argv) {
+  if (argc != 5) {
+    std::cerr << "Usage: " << argv[0]
+      << " <logFile> <calibrationFile> <poseFile> <bulkFile>" << std::endl
+      << "The pose file holds one sensor pose per line: timestamp [ns], "
+      "x, y, z, qw, qx, qy, qz" << std::endl;
+    return -1;
+  }
+  PacketLogReader logReader(argv[1]);
+  Calibration calibration;
+  calibration.load(argv[2]);
+  std::ifstream poseFile(argv[3]);
+  if (!poseFile.is_open()) {
+    std::cerr << "Could not open " << argv[3] << std::endl;
+    return -1;
+  }
+  PoseInterpolator poses(std::numeric_limits<size_t>::max());
+  int64_t timestamp;
+  double x, y, z, qw, qx, qy, qz;
+  while (poseFile >> timestamp >> x >> y >> z >> qw >> qx >> qy >> qz)
+    poses.addPose(timestamp, Pose(x, y, z, qw, qx, qy, qz));
+  if (!poses.getSize()) {
+    std::cerr << "No poses in " << argv[3] << std::endl;
+    return -1;
+  }
+  std::ofstream bulkFile(argv[4], std::ios::binary);
+  RevolutionAssembler<VdynePointCloud> assembler(calibration);
+  assembler.setMotionModel(&poses);
+  size_t numRevolutions = 0;
+  for (size_t i = 0; i < logReader.getNumPackets(); ++i)
+    if (assembler.addPacket(logReader.getPacket(i))) {
+      assembler.getRevolution().writeBulk(bulkFile);
+      ++numRevolutions;
+    }
+  if (assembler.flush()) {
+    assembler.getRevolution().writeBulk(bulkFile);
+    ++numRevolutions;
+  }
+  std::cout << logReader.getNumPackets() << " packets, " << numRevolutions
+    << " revolutions" << std::endl;
+  return 0;
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file indexLog.cpp
+    \brief This file is a testing binary for rebuilding the revolution index
+           of a log file of Velodyne data packets.
+  */
+
+#include <iostream>
+
+#include "sensor/PacketLogReader.h"
+#include "sensor/LogIndex.h"
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <LogFile>" << std::endl;
+    return -1;
+  }
+  PacketLogReader logReader(argv[1]);
+  LogIndex logIndex;
+  logIndex.build(logReader);
+  logIndex.open(LogIndex::getFilename(argv[1]));
+  logIndex.close();
+  std::cout << logReader.getNumPackets() << " packets, "
+    << logIndex.getNumRevolutions() << " revolutions" << std::endl;
+  return 0;
+}
@@ -23,19 +23,23 @@
 #include <cstdlib>
 
 #include <iostream>
-#include <fstream>
 
 #include "com/UDPConnectionServer.h"
 #include "sensor/DataPacket.h"
+#include "sensor/PacketLogger.h"
 #include "exceptions/IOException.h"
 #include "exceptions/SystemException.h"
 
 int main(int argc, char **argv) {
-  if (argc != 3) {
-    std::cerr << "Usage: " << argv[0] << " <LogFile> <PktNbr>" << std::endl;
+  if ((argc != 3) && (argc != 4)) {
+    std::cerr << "Usage: " << argv[0] << " <LogFile> <PktNbr> [Compress]"
+      << std::endl;
     return -1;
   }
   UDPConnectionServer com(2368);
+  const bool compress = (argc == 4) && atoi(argv[3]);
+  PacketLogger logger(argv[1], 2048, 8, false, 0, 0.0, 1.0, compress);
+  logger.start();
   const size_t numPackets = atoi(argv[2]);
   size_t packetCount = 0;
   while (packetCount < numPackets) {
@@ -51,9 +55,12 @@ int main(int argc, char **argv) {
       std::cerr << e.what() << std::endl;
       continue;
     }
-    std::ofstream logFile(argv[1], std::ios::app);
-    dataPacket.writeBinary(logFile);
+    logger.log(dataPacket);
     packetCount++;
   }
+  logger.interrupt();
+  if (logger.getNumDropped() || logger.getNumFailed())
+    std::cerr << "Dropped " << logger.getNumDropped() << " and failed "
+      << logger.getNumFailed() << " packets" << std::endl;
   return 0;
 }
@@ -24,27 +24,40 @@
 #include <cstdlib>
 
 #include <iostream>
-#include <fstream>
 
 #include "sensor/AcquisitionThread.h"
 #include "sensor/DataPacket.h"
+#include "sensor/PacketLogger.h"
 
 int main(int argc, char **argv) {
-  if (argc != 3) {
-    std::cerr << "Usage: " << argv[0] << " <LogFile> <PktNbr>" << std::endl;
+  if ((argc != 3) && (argc != 4)) {
+    std::cerr << "Usage: " << argv[0] << " <LogFile> <PktNbr> [Compress]"
+      << std::endl;
     return -1;
   }
+  const bool compress = (argc == 4) && atoi(argv[3]);
+  PacketLogger logger(argv[1], 2048, 8, false, 0, 0.0, 1.0, compress);
+  logger.start();
   UDPConnectionServer connection(2368);
   AcquisitionThread<DataPacket> acqThread(connection);
   acqThread.start();
   const size_t numPackets = atoi(argv[2]);
   size_t packetCount = 0;
+  AcquisitionThread<DataPacket>::Buffer::Container packets;
   while (packetCount < numPackets)
-    if (!acqThread.getBuffer().isEmpty()) {
-      std::ofstream logFile (argv[1], std::ios::app);
-      acqThread.getBuffer().dequeue()->writeBinary(logFile);
-      packetCount++;
+    if (acqThread.getBuffer().waitNotEmpty(1.0)) {
+      acqThread.getBuffer().dequeueAll(packets);
+      while (!packets.empty() && packetCount < numPackets) {
+        logger.log(*packets.front());
+        packets.pop_front();
+        packetCount++;
+      }
+      packets.clear();
     }
   acqThread.interrupt();
+  logger.interrupt();
+  if (logger.getNumDropped() || logger.getNumFailed())
+    std::cerr << "Dropped " << logger.getNumDropped() << " and failed "
+      << logger.getNumFailed() << " packets" << std::endl;
   return 0;
 }
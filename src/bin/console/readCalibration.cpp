@@ -26,13 +26,17 @@
 #include "sensor/Calibration.h"
 
 int main(int argc, char **argv) {
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <calibrationFile>" << std::endl;
+  if (argc != 2 && argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <calibrationFile> [binaryFile]"
+      << std::endl;
     return -1;
   }
   Calibration calibration;
-  std::ifstream calibFile(argv[1]);
-  calibFile >> calibration;
+  calibration.load(argv[1]);
   std::cout << calibration;
+  if (argc == 3) {
+    std::ofstream binaryFile(argv[2], std::ios::out | std::ios::binary);
+    calibration.writeBinary(binaryFile);
+  }
   return 0;
 }
@@ -22,22 +22,19 @@
   */
 
 #include <iostream>
-#include <fstream>
 
 #include "sensor/DataPacket.h"
+#include "sensor/PacketLogReader.h"
 
 int main(int argc, char **argv) {
   if (argc != 2) {
     std::cerr << "Usage: " << argv[0] << " <LogFile>" << std::endl;
     return -1;
   }
-  std::ifstream logFile(argv[1]);
-  logFile.seekg (0, std::ios::end);
-  const int length = logFile.tellg();
-  logFile.seekg (0, std::ios::beg);
-  while (logFile.tellg() != length) {
-    DataPacket dataPacket;
-    dataPacket.readBinary(logFile);
+  PacketLogReader logReader(argv[1]);
+  DataPacket dataPacket;
+  for (size_t i = 0; i < logReader.getNumPackets(); ++i) {
+    dataPacket.readBinary(logReader.getPacket(i));
     std::cout << dataPacket;
   }
   return 0;
@@ -25,8 +25,8 @@
 #include <fstream>
 
 #include "sensor/Calibration.h"
-#include "sensor/DataPacket.h"
-#include "sensor/Converter.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/BatchConverter.h"
 #include "data-structures/VdynePointCloud.h"
 
 int main(int argc, char **argv) {
@@ -35,17 +35,11 @@ int main(int argc, char **argv) {
       << " <logFile> <calibrationFile> <asciiFile>" << std::endl;
     return -1;
   }
-  std::ifstream logFile(argv[1]);
+  PacketLogReader logReader(argv[1]);
   Calibration calibration;
-  std::ifstream calibFile(argv[2]);
-  calibFile >> calibration;
+  calibration.load(argv[2]);
   std::ofstream asciiFile(argv[3]);
-  while (logFile.eof() != true) {
-    DataPacket dataPacket;
-    dataPacket.readBinary(logFile);
-    VdynePointCloud pointCloud;
-    Converter::toPointCloud(dataPacket, calibration, pointCloud);
-    asciiFile << pointCloud;
-  }
+  BatchConverter<VdynePointCloud> converter(calibration);
+  converter.convert(logReader, asciiFile);
   return 0;
 }
@@ -25,33 +25,34 @@
 #include <fstream>
 
 #include "sensor/Calibration.h"
-#include "sensor/DataPacket.h"
-#include "sensor/Converter.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/BatchConverter.h"
 #include "data-structures/VdynePointCloud.h"
 
+void writePoints(const VdynePointCloud& pointCloud, std::ostream& stream) {
+  for (auto it = pointCloud.getPointBegin(); it != pointCloud.getPointEnd();
+      ++it)
+    stream << "            " << it->mX << " " << it->mY << " " << it->mZ
+      << "," << std::endl;
+}
+
 int main(int argc, char **argv) {
   if (argc != 4) {
     std::cerr << "Usage: " << argv[0]
       << " <logFile> <calibrationFile> <wrmlFile>" << std::endl;
     return -1;
   }
-  std::ifstream logFile(argv[1]);
+  PacketLogReader logReader(argv[1]);
   Calibration calibration;
-  std::ifstream calibFile(argv[2]);
-  calibFile >> calibration;
+  calibration.load(argv[2]);
   std::ofstream wrmlFile(argv[3]);
   wrmlFile << "#VRML V2.0 utf8" << std::endl
            << "Shape {" << std::endl
            << "   geometry PointSet {" << std::endl
            << "      coord Coordinate {" << std::endl
            << "         point [" <<std:: endl;
-  while (logFile.eof() != true) {
-    DataPacket dataPacket;
-    dataPacket.readBinary(logFile);
-    VdynePointCloud pointCloud;
-    Converter::toPointCloud(dataPacket, calibration, pointCloud);
-    wrmlFile << pointCloud;
-  }
+  BatchConverter<VdynePointCloud> converter(calibration, writePoints);
+  converter.convert(logReader, wrmlFile);
   wrmlFile << "         ]" << std::endl
            << "      }" << std::endl
            << "   }" << std::endl
@@ -23,6 +23,8 @@
 #include <cmath>
 #include <unistd.h>
 
+#include <chrono>
+
 #include "exceptions/IOException.h"
 #include "exceptions/SystemException.h"
 
@@ -33,7 +35,8 @@
 UDPConnectionServer::UDPConnectionServer(short port, double timeout) :
     mPort(port),
     mTimeout(timeout),
-    mSocket(0) {
+    mSocket(0),
+    mKernelTimestamps(false) {
 }
 
 UDPConnectionServer::~UDPConnectionServer() {
@@ -74,6 +77,16 @@ double UDPConnectionServer::getTimeout() const {
   return mTimeout;
 }
 
+void UDPConnectionServer::setKernelTimestamps(bool kernelTimestamps) {
+  mKernelTimestamps = kernelTimestamps;
+  if (isOpen())
+    applyKernelTimestamps();
+}
+
+bool UDPConnectionServer::getKernelTimestamps() const {
+  return mKernelTimestamps;
+}
+
 /******************************************************************************/
 /* Methods                                                                    */
 /******************************************************************************/
@@ -96,6 +109,8 @@ void UDPConnectionServer::open() {
     close();
     throw SystemException(errno, "UDPConnectionServer::open()::bind()");
   }
+  if (mKernelTimestamps)
+    applyKernelTimestamps();
 }
 
 void UDPConnectionServer::close() {
@@ -111,9 +126,15 @@ bool UDPConnectionServer::isOpen() const {
   return (mSocket != 0);
 }
 
-size_t UDPConnectionServer::read(char* buffer, size_t numBytes) {
-  if (!isOpen())
-    open();
+void UDPConnectionServer::applyKernelTimestamps() {
+  const int enable = mKernelTimestamps;
+  if (setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+      sizeof(enable)) == -1)
+    throw SystemException(errno,
+      "UDPConnectionServer::applyKernelTimestamps()::setsockopt()");
+}
+
+bool UDPConnectionServer::waitReadable() {
   double intPart;
   double fracPart = modf(mTimeout, &intPart);
   struct timeval waitd;
@@ -124,12 +145,49 @@ size_t UDPConnectionServer::read(char* buffer, size_t numBytes) {
   FD_SET(mSocket, &readFlags);
   ssize_t res = select(mSocket + 1, &readFlags, (fd_set*)0, (fd_set*)0, &waitd);
   if(res < 0)
-    throw SystemException(errno, "UDPConnectionServer::read()::select()");
-  if (FD_ISSET(mSocket, &readFlags)) {
-    FD_CLR(mSocket, &readFlags);
-    res = recvfrom(mSocket, buffer, numBytes, 0, NULL, 0);
+    throw SystemException(errno,
+      "UDPConnectionServer::waitReadable()::select()");
+  return FD_ISSET(mSocket, &readFlags);
+}
+
+int64_t UDPConnectionServer::getTimestamp(const struct msghdr& message) const {
+  if (mKernelTimestamps)
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL;
+        cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&message), cmsg))
+      if ((cmsg->cmsg_level == SOL_SOCKET) &&
+          (cmsg->cmsg_type == SCM_TIMESTAMPNS)) {
+        struct timespec time;
+        memcpy(&time, CMSG_DATA(cmsg), sizeof(time));
+        return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+      }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+size_t UDPConnectionServer::read(char* buffer, size_t numBytes) {
+  int64_t timestamp;
+  return read(buffer, numBytes, timestamp);
+}
+
+size_t UDPConnectionServer::read(char* buffer, size_t numBytes, int64_t&
+    timestamp) {
+  if (!isOpen())
+    open();
+  if (waitReadable()) {
+    struct iovec ioVector;
+    ioVector.iov_base = buffer;
+    ioVector.iov_len = numBytes;
+    char control[CMSG_SPACE(sizeof(struct timespec))];
+    struct msghdr message;
+    memset(&message, 0, sizeof(struct msghdr));
+    message.msg_iov = &ioVector;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t res = recvmsg(mSocket, &message, 0);
     if (res < 0)
-        throw SystemException(errno, "UDPConnectionServer::read()::read()");
+        throw SystemException(errno, "UDPConnectionServer::read()::recvmsg()");
+    timestamp = getTimestamp(message);
     return res;
   }
   else
@@ -137,6 +195,42 @@ size_t UDPConnectionServer::read(char* buffer, size_t numBytes) {
   return 0;
 }
 
+size_t UDPConnectionServer::readBatch(char* buffer, size_t packetSize, size_t
+    maxPackets, size_t* numBytes, int64_t* timestamps) {
+  if (!isOpen())
+    open();
+  const size_t controlSize = CMSG_SPACE(sizeof(struct timespec));
+  if (mMessages.size() < maxPackets) {
+    mMessages.resize(maxPackets);
+    mIOVectors.resize(maxPackets);
+    mControlBuffers.resize(maxPackets * controlSize);
+  }
+  for (size_t i = 0; i < maxPackets; ++i) {
+    mIOVectors[i].iov_base = &buffer[i * packetSize];
+    mIOVectors[i].iov_len = packetSize;
+    memset(&mMessages[i], 0, sizeof(struct mmsghdr));
+    mMessages[i].msg_hdr.msg_iov = &mIOVectors[i];
+    mMessages[i].msg_hdr.msg_iovlen = 1;
+    mMessages[i].msg_hdr.msg_control = &mControlBuffers[i * controlSize];
+    mMessages[i].msg_hdr.msg_controllen = controlSize;
+  }
+  if (waitReadable()) {
+    ssize_t res = recvmmsg(mSocket, &mMessages[0], maxPackets, MSG_DONTWAIT,
+      NULL);
+    if (res < 0)
+      throw SystemException(errno,
+        "UDPConnectionServer::readBatch()::recvmmsg()");
+    for (ssize_t i = 0; i < res; ++i) {
+      numBytes[i] = mMessages[i].msg_len;
+      timestamps[i] = getTimestamp(mMessages[i].msg_hdr);
+    }
+    return res;
+  }
+  else
+    throw IOException("UDPConnectionServer::readBatch(): timeout occured");
+  return 0;
+}
+
 void UDPConnectionServer::write(const char* buffer, size_t numBytes) {
   if (!isOpen())
     open();
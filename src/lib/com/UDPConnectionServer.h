@@ -24,7 +24,11 @@
 #ifndef UDPCONNECTIONSERVER_H
 #define UDPCONNECTIONSERVER_H
 
+#include <sys/socket.h>
+
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "base/Serializable.h"
 
@@ -64,6 +68,10 @@ public:
   double getTimeout() const;
   /// Returns the binded port
   short getPort() const;
+  /// Enables kernel receive timestamps (SO_TIMESTAMPNS)
+  void setKernelTimestamps(bool kernelTimestamps);
+  /// Returns whether kernel receive timestamps are enabled
+  bool getKernelTimestamps() const;
  /** @}
     */
 
@@ -78,6 +86,11 @@ public:
   bool isOpen() const;
   /// Read buffer from UDP
   size_t read(char* buffer, size_t numBytes);
+  /// Read buffer from UDP along with its arrival time [ns]
+  size_t read(char* buffer, size_t numBytes, int64_t& timestamp);
+  /// Read a batch of datagrams from UDP, returns the number of datagrams
+  size_t readBatch(char* buffer, size_t packetSize, size_t maxPackets,
+    size_t* numBytes, int64_t* timestamps);
   /// Write buffer to UDP
   void write(const char* buffer, size_t numBytes);
  /** @}
@@ -98,6 +111,18 @@ protected:
   /** @}
     */
 
+  /** \name Protected methods
+    @{
+    */
+  /// Apply the timestamping option to the socket
+  void applyKernelTimestamps();
+  /// Wait until the socket is readable or the timeout expires
+  bool waitReadable();
+  /// Returns the arrival time of a received message [ns]
+  int64_t getTimestamp(const struct msghdr& message) const;
+  /** @}
+    */
+
   /** \name Protected members
     @{
     */
@@ -107,6 +132,14 @@ protected:
   double mTimeout;
   /// Socket for the port
   ssize_t mSocket;
+  /// Kernel receive timestamps enabled
+  bool mKernelTimestamps;
+  /// Message headers for batched reception
+  std::vector<struct mmsghdr> mMessages;
+  /// Scatter/gather vectors for batched reception
+  std::vector<struct iovec> mIOVectors;
+  /// Control message buffers for batched reception
+  std::vector<char> mControlBuffers;
   /** @}
     */
 
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file AlignedAllocator.h
+    \brief This file defines the AlignedAllocator class, which represents an
+           allocator returning aligned memory.
+  */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+
+/** The class AlignedAllocator represents a standard allocator returning
+    memory aligned on a given boundary, e.g., for SIMD loads on containers.
+    \brief Aligned memory allocator
+  */
+template <typename T, size_t A = 64> class AlignedAllocator {
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Value type
+  typedef T value_type;
+  /// Pointer type
+  typedef T* pointer;
+  /// Constant pointer type
+  typedef const T* const_pointer;
+  /// Reference type
+  typedef T& reference;
+  /// Constant reference type
+  typedef const T& const_reference;
+  /// Size type
+  typedef size_t size_type;
+  /// Difference type
+  typedef ptrdiff_t difference_type;
+  /// Rebinds the allocator to another type
+  template <typename U> struct rebind {
+    /// Rebound allocator type
+    typedef AlignedAllocator<U, A> other;
+  };
+  /** @}
+    */
+
+  /** \name Constants
+    @{
+    */
+  /// Alignment in bytes
+  static const size_t mAlignment = A;
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Default constructor
+  AlignedAllocator();
+  /// Copy constructor
+  AlignedAllocator(const AlignedAllocator& other);
+  /// Copy constructor from another type
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, A>& other);
+  /// Destructor
+  ~AlignedAllocator();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the maximum number of elements which can be allocated
+  size_type max_size() const;
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Allocates aligned memory for a number of elements
+  pointer allocate(size_type numElements, const void* hint = 0);
+  /// Deallocates memory
+  void deallocate(pointer p, size_type numElements);
+  /// Constructs an element in allocated memory
+  void construct(pointer p, const T& value);
+  /// Destroys an element in allocated memory
+  void destroy(pointer p);
+  /** @}
+    */
+
+};
+
+/// Allocators with same alignment can deallocate each other's memory
+template <typename T, typename U, size_t A>
+bool operator == (const AlignedAllocator<T, A>& lhs, const
+  AlignedAllocator<U, A>& rhs);
+/// Allocators with same alignment can deallocate each other's memory
+template <typename T, typename U, size_t A>
+bool operator != (const AlignedAllocator<T, A>& lhs, const
+  AlignedAllocator<U, A>& rhs);
+
+#include "data-structures/AlignedAllocator.tpp"
+
+#endif // ALIGNEDALLOCATOR_H
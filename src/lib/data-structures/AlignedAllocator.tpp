@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <cstdlib>
+
+#include <limits>
+#include <new>
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+template <typename T, size_t A>
+AlignedAllocator<T, A>::AlignedAllocator() {
+}
+
+template <typename T, size_t A>
+AlignedAllocator<T, A>::AlignedAllocator(const AlignedAllocator& /*other*/) {
+}
+
+template <typename T, size_t A>
+template <typename U>
+AlignedAllocator<T, A>::AlignedAllocator(const AlignedAllocator<U, A>&
+    /*other*/) {
+}
+
+template <typename T, size_t A>
+AlignedAllocator<T, A>::~AlignedAllocator() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+template <typename T, size_t A>
+typename AlignedAllocator<T, A>::size_type AlignedAllocator<T, A>::max_size()
+    const {
+  return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+template <typename T, size_t A>
+typename AlignedAllocator<T, A>::pointer AlignedAllocator<T, A>::allocate(
+    size_type numElements, const void* /*hint*/) {
+  if (numElements > max_size())
+    throw std::bad_alloc();
+  void* p = 0;
+  if (posix_memalign(&p, A, numElements * sizeof(T)))
+    throw std::bad_alloc();
+  return static_cast<pointer>(p);
+}
+
+template <typename T, size_t A>
+void AlignedAllocator<T, A>::deallocate(pointer p, size_type
+    /*numElements*/) {
+  free(p);
+}
+
+template <typename T, size_t A>
+void AlignedAllocator<T, A>::construct(pointer p, const T& value) {
+  new(p) T(value);
+}
+
+template <typename T, size_t A>
+void AlignedAllocator<T, A>::destroy(pointer p) {
+  p->~T();
+}
+
+template <typename T, typename U, size_t A>
+bool operator == (const AlignedAllocator<T, A>& /*lhs*/, const
+    AlignedAllocator<U, A>& /*rhs*/) {
+  return true;
+}
+
+template <typename T, typename U, size_t A>
+bool operator != (const AlignedAllocator<T, A>& /*lhs*/, const
+    AlignedAllocator<U, A>& /*rhs*/) {
+  return false;
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "data-structures/BulkHeader.h"
+
+#include <cstring>
+
+#include <iostream>
+#include <limits>
+
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+BulkHeader::BulkHeader(const char magic[4], uint32_t version) :
+    mVersion(version),
+    mTimestamp(0),
+    mStartRotationAngle(0),
+    mEndRotationAngle(0),
+    mRecordSize(0),
+    mNumRecords(0) {
+  memcpy(mMagic, magic, sizeof(mMagic));
+}
+
+BulkHeader::BulkHeader(const BulkHeader& other) :
+    mVersion(other.mVersion),
+    mTimestamp(other.mTimestamp),
+    mStartRotationAngle(other.mStartRotationAngle),
+    mEndRotationAngle(other.mEndRotationAngle),
+    mRecordSize(other.mRecordSize),
+    mNumRecords(other.mNumRecords) {
+  memcpy(mMagic, other.mMagic, sizeof(mMagic));
+}
+
+BulkHeader& BulkHeader::operator = (const BulkHeader& other) {
+  if (this != &other) {
+    memcpy(mMagic, other.mMagic, sizeof(mMagic));
+    mVersion = other.mVersion;
+    mTimestamp = other.mTimestamp;
+    mStartRotationAngle = other.mStartRotationAngle;
+    mEndRotationAngle = other.mEndRotationAngle;
+    mRecordSize = other.mRecordSize;
+    mNumRecords = other.mNumRecords;
+  }
+  return *this;
+}
+
+BulkHeader::~BulkHeader() {
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void BulkHeader::write(std::ostream& stream) const {
+  const uint32_t marker = mByteOrderMarker;
+  stream.write(mMagic, sizeof(mMagic));
+  stream.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+  stream.write(reinterpret_cast<const char*>(&mVersion), sizeof(mVersion));
+  stream.write(reinterpret_cast<const char*>(&mRecordSize),
+    sizeof(mRecordSize));
+  stream.write(reinterpret_cast<const char*>(&mTimestamp),
+    sizeof(mTimestamp));
+  stream.write(reinterpret_cast<const char*>(&mStartRotationAngle),
+    sizeof(mStartRotationAngle));
+  stream.write(reinterpret_cast<const char*>(&mEndRotationAngle),
+    sizeof(mEndRotationAngle));
+  stream.write(reinterpret_cast<const char*>(&mNumRecords),
+    sizeof(mNumRecords));
+}
+
+void BulkHeader::read(std::istream& stream) {
+  char magic[sizeof(mMagic)];
+  uint32_t marker;
+  uint32_t version;
+  uint32_t recordSize;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&marker), sizeof(marker));
+  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+  stream.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize));
+  stream.read(reinterpret_cast<char*>(&mTimestamp), sizeof(mTimestamp));
+  stream.read(reinterpret_cast<char*>(&mStartRotationAngle),
+    sizeof(mStartRotationAngle));
+  stream.read(reinterpret_cast<char*>(&mEndRotationAngle),
+    sizeof(mEndRotationAngle));
+  stream.read(reinterpret_cast<char*>(&mNumRecords), sizeof(mNumRecords));
+  if (!stream)
+    throw IOException("BulkHeader::read(): truncated header");
+  if (memcmp(magic, mMagic, sizeof(mMagic)))
+    throw IOException("BulkHeader::read(): bad magic number");
+  if (marker != mByteOrderMarker)
+    throw IOException("BulkHeader::read(): unsupported byte order");
+  if (version != mVersion)
+    throw IOException("BulkHeader::read(): unsupported version");
+  if (recordSize != mRecordSize)
+    throw IOException("BulkHeader::read(): unexpected record size");
+  if (mRecordSize && (mNumRecords > std::numeric_limits<size_t>::max() /
+      mRecordSize))
+    throw IOException("BulkHeader::read(): too many records");
+  const std::streampos position = stream.tellg();
+  if (position == std::streampos(-1))
+    return;
+  stream.seekg(0, std::ios::end);
+  const std::streampos end = stream.tellg();
+  stream.seekg(position);
+  if (!stream || (end == std::streampos(-1)))
+    throw IOException("BulkHeader::read(): cannot seek stream");
+  if (mNumRecords * mRecordSize > static_cast<uint64_t>(end - position))
+    throw IOException("BulkHeader::read(): records exceed stream length");
+}
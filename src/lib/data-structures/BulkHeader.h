@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file BulkHeader.h
+    \brief This file defines the BulkHeader class, which represents the header
+           of the bulk binary format of the clouds
+  */
+
+#ifndef BULKHEADER_H
+#define BULKHEADER_H
+
+#include <cstdint>
+
+#include <iosfwd>
+
+/** The class BulkHeader represents the header of the bulk binary format of the
+    clouds. It carries a magic number identifying the cloud type, a version,
+    a byte order marker written in native order and the number of records
+    that follow it as one contiguous block.
+    \brief Bulk binary format header
+  */
+class BulkHeader {
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs from a magic number
+  BulkHeader(const char magic[4], uint32_t version);
+  /// Copy constructor
+  BulkHeader(const BulkHeader& other);
+  /// Assignment operator
+  BulkHeader& operator = (const BulkHeader& other);
+  /// Destructor
+  ~BulkHeader();
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Writes into an output stream
+  void write(std::ostream& stream) const;
+  /// Reads from an input stream, checks the magic, version, byte order and
+  /// on seekable streams that the records fit in the remaining length
+  void read(std::istream& stream);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Byte order marker
+  static const uint32_t mByteOrderMarker = 0x01020304;
+  /// Magic number of the cloud type
+  char mMagic[4];
+  /// Version of the format
+  uint32_t mVersion;
+  /// Timestamp of the cloud
+  int64_t mTimestamp;
+  /// Start angle of the cloud
+  float mStartRotationAngle;
+  /// End angle of the cloud
+  float mEndRotationAngle;
+  /// Size of a record
+  uint32_t mRecordSize;
+  /// Number of records
+  uint64_t mNumRecords;
+  /** @}
+    */
+
+};
+
+#endif // BULKHEADER_H
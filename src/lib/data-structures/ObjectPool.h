@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file ObjectPool.h
+    \brief This file defines the ObjectPool class, which represents a pool of
+           recycled shared objects.
+  */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "base/Mutex.h"
+
+/** The class ObjectPool represents a pool of preallocated objects handed out
+    as shared pointers. The free objects are kept in a free list, and the
+    deleter of a handle returns its object to the free list in O(1) as soon
+    as the last copy of the handle is released, possibly from another
+    thread. The control blocks of the handles are recycled as well, so that
+    no allocation happens in steady state. When no object is free, the pool
+    grows by one object up to its maximum size, and otherwise acquire()
+    returns an empty handle; both count as an exhaustion. The objects are
+    shared with the handles, so that handles may outlive the pool.
+    \brief Pool of recycled shared objects
+  */
+template <typename T> class ObjectPool {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  ObjectPool(const ObjectPool& other);
+  /// Assignment operator
+  ObjectPool& operator = (const ObjectPool& other);
+  /** @}
+    */
+
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs pool with initial and maximum number of objects
+  ObjectPool(size_t size = 1024, size_t maxSize =
+    std::numeric_limits<size_t>::max());
+  /// Destructor
+  ~ObjectPool();
+  /** @}
+    */
+
+  /** \name Accessors
+      @{
+    */
+  /// Returns the number of objects owned by the pool
+  size_t getSize() const;
+  /// Returns the maximum number of objects
+  size_t getMaxSize() const;
+  /// Returns the number of free objects
+  size_t getNumFree() const;
+  /// Returns the number of times the pool was exhausted
+  size_t getNumExhaustions() const;
+  /** @}
+    */
+
+  /** \name Methods
+      @{
+    */
+  /// Returns a free object, or an empty handle if the pool is exhausted
+  std::shared_ptr<T> acquire();
+  /** @}
+    */
+
+protected:
+  /** \name Protected types definitions
+    @{
+    */
+  /// The struct Storage holds the objects, shared by the pool and handles.
+  struct Storage {
+    /// Default constructor
+    Storage() :
+        mBlockSize(0),
+        mNumExhaustions(0) {}
+    /// Destructor
+    ~Storage();
+    /// Mutex protecting the storage
+    Mutex mMutex;
+    /// Objects owned by the pool
+    std::vector<T*> mObjects;
+    /// Free objects
+    std::vector<T*> mFreeObjects;
+    /// Free control blocks
+    std::vector<void*> mFreeBlocks;
+    /// Size of a control block
+    size_t mBlockSize;
+    /// Number of exhaustions
+    size_t mNumExhaustions;
+  };
+  /// The class Deleter returns the object of a handle to the free list.
+  class Deleter {
+  public:
+    /// Constructs deleter for a storage
+    Deleter(const std::shared_ptr<Storage>& storage) :
+        mStorage(storage) {}
+    /// Returns an object to the free list
+    void operator () (T* object) const {
+      Mutex::ScopedLock lock(mStorage->mMutex);
+      mStorage->mFreeObjects.push_back(object);
+    }
+  protected:
+    /// Storage of the object
+    std::shared_ptr<Storage> mStorage;
+  };
+  /// The class Allocator recycles the control blocks of the handles.
+  template <typename U> class Allocator {
+  public:
+    /// Value type
+    typedef U value_type;
+    /// Rebinds the allocator to another type
+    template <typename V> struct rebind {
+      /// Rebound allocator
+      typedef Allocator<V> other;
+    };
+    /// Constructs allocator for a storage
+    Allocator(const std::shared_ptr<Storage>& storage) :
+        mStorage(storage) {}
+    /// Constructs allocator from another type
+    template <typename V> Allocator(const Allocator<V>& other) :
+        mStorage(other.mStorage) {}
+    /// Allocates a control block, recycled if possible
+    U* allocate(size_t n) {
+      const size_t size = n * sizeof(U);
+      {
+        Mutex::ScopedLock lock(mStorage->mMutex);
+        if (!mStorage->mBlockSize)
+          mStorage->mBlockSize = size;
+        if ((size == mStorage->mBlockSize) &&
+            !mStorage->mFreeBlocks.empty()) {
+          void* block = mStorage->mFreeBlocks.back();
+          mStorage->mFreeBlocks.pop_back();
+          return static_cast<U*>(block);
+        }
+      }
+      return static_cast<U*>(::operator new(size));
+    }
+    /// Returns a control block to the free list
+    void deallocate(U* block, size_t n) {
+      {
+        Mutex::ScopedLock lock(mStorage->mMutex);
+        if ((n * sizeof(U) == mStorage->mBlockSize) &&
+            (mStorage->mFreeBlocks.size() <
+            mStorage->mFreeBlocks.capacity())) {
+          mStorage->mFreeBlocks.push_back(block);
+          return;
+        }
+      }
+      ::operator delete(block);
+    }
+    /// Equality comparison
+    template <typename V> bool operator == (const Allocator<V>& other)
+        const {
+      return mStorage == other.mStorage;
+    }
+    /// Inequality comparison
+    template <typename V> bool operator != (const Allocator<V>& other)
+        const {
+      return mStorage != other.mStorage;
+    }
+    /// Storage of the control blocks
+    std::shared_ptr<Storage> mStorage;
+  };
+  /** @}
+    */
+
+  /** \name Protected methods
+    @{
+    */
+  /// Adds an object to the storage, which must be locked
+  void addObject();
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Storage shared with the handles
+  std::shared_ptr<Storage> mStorage;
+  /// Maximum number of objects
+  size_t mMaxSize;
+  /** @}
+    */
+
+};
+
+#include "data-structures/ObjectPool.tpp"
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+template <typename T>
+ObjectPool<T>::ObjectPool(size_t size, size_t maxSize) :
+    mStorage(new Storage()),
+    mMaxSize(maxSize) {
+  Mutex::ScopedLock lock(mStorage->mMutex);
+  for (size_t i = 0; i < size; ++i)
+    addObject();
+}
+
+template <typename T>
+ObjectPool<T>::~ObjectPool() {
+}
+
+template <typename T>
+ObjectPool<T>::Storage::~Storage() {
+  for (size_t i = 0; i < mObjects.size(); ++i)
+    delete mObjects[i];
+  for (size_t i = 0; i < mFreeBlocks.size(); ++i)
+    ::operator delete(mFreeBlocks[i]);
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+template <typename T>
+size_t ObjectPool<T>::getSize() const {
+  Mutex::ScopedLock lock(mStorage->mMutex);
+  return mStorage->mObjects.size();
+}
+
+template <typename T>
+size_t ObjectPool<T>::getMaxSize() const {
+  return mMaxSize;
+}
+
+template <typename T>
+size_t ObjectPool<T>::getNumFree() const {
+  Mutex::ScopedLock lock(mStorage->mMutex);
+  return mStorage->mFreeObjects.size();
+}
+
+template <typename T>
+size_t ObjectPool<T>::getNumExhaustions() const {
+  Mutex::ScopedLock lock(mStorage->mMutex);
+  return mStorage->mNumExhaustions;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+template <typename T>
+void ObjectPool<T>::addObject() {
+  mStorage->mObjects.push_back(new T());
+  mStorage->mFreeObjects.reserve(mStorage->mObjects.size());
+  mStorage->mFreeBlocks.reserve(mStorage->mObjects.size());
+  mStorage->mFreeObjects.push_back(mStorage->mObjects.back());
+}
+
+template <typename T>
+std::shared_ptr<T> ObjectPool<T>::acquire() {
+  T* object = 0;
+  {
+    Mutex::ScopedLock lock(mStorage->mMutex);
+    if (mStorage->mFreeObjects.empty()) {
+      ++mStorage->mNumExhaustions;
+      if (mStorage->mObjects.size() >= mMaxSize)
+        return std::shared_ptr<T>();
+      addObject();
+    }
+    object = mStorage->mFreeObjects.back();
+    mStorage->mFreeObjects.pop_back();
+  }
+  return std::shared_ptr<T>(object, Deleter(mStorage),
+    Allocator<T>(mStorage));
+}
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "data-structures/Pose.h"
+
+#include <cmath>
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+Pose::Pose() {
+  mTranslation[0] = mTranslation[1] = mTranslation[2] = 0;
+  mRotation[0] = 1;
+  mRotation[1] = mRotation[2] = mRotation[3] = 0;
+}
+
+Pose::Pose(double x, double y, double z, double qw, double qx, double qy,
+    double qz) {
+  mTranslation[0] = x;
+  mTranslation[1] = y;
+  mTranslation[2] = z;
+  mRotation[0] = qw;
+  mRotation[1] = qx;
+  mRotation[2] = qy;
+  mRotation[3] = qz;
+  normalize();
+}
+
+Pose::Pose(const Pose& other) {
+  for (size_t i = 0; i < 3; ++i)
+    mTranslation[i] = other.mTranslation[i];
+  for (size_t i = 0; i < 4; ++i)
+    mRotation[i] = other.mRotation[i];
+}
+
+Pose& Pose::operator = (const Pose& other) {
+  if (this != &other) {
+    for (size_t i = 0; i < 3; ++i)
+      mTranslation[i] = other.mTranslation[i];
+    for (size_t i = 0; i < 4; ++i)
+      mRotation[i] = other.mRotation[i];
+  }
+  return *this;
+}
+
+Pose::~Pose() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+void Pose::getMatrix(float matrix[12]) const {
+  const double w = mRotation[0];
+  const double x = mRotation[1];
+  const double y = mRotation[2];
+  const double z = mRotation[3];
+  matrix[0] = 1 - 2 * (y * y + z * z);
+  matrix[1] = 2 * (x * y - w * z);
+  matrix[2] = 2 * (x * z + w * y);
+  matrix[3] = mTranslation[0];
+  matrix[4] = 2 * (x * y + w * z);
+  matrix[5] = 1 - 2 * (x * x + z * z);
+  matrix[6] = 2 * (y * z - w * x);
+  matrix[7] = mTranslation[1];
+  matrix[8] = 2 * (x * z - w * y);
+  matrix[9] = 2 * (y * z + w * x);
+  matrix[10] = 1 - 2 * (x * x + y * y);
+  matrix[11] = mTranslation[2];
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+Pose Pose::fromRotationVector(double x, double y, double z, double rx, double
+    ry, double rz) {
+  const double angle = std::sqrt(rx * rx + ry * ry + rz * rz);
+  if (angle < 1e-12)
+    return Pose(x, y, z, 1, rx / 2, ry / 2, rz / 2);
+  const double scale = std::sin(angle / 2) / angle;
+  return Pose(x, y, z, std::cos(angle / 2), rx * scale, ry * scale,
+    rz * scale);
+}
+
+Pose Pose::operator * (const Pose& other) const {
+  const double* a = mRotation;
+  const double* b = other.mRotation;
+  double x = other.mTranslation[0];
+  double y = other.mTranslation[1];
+  double z = other.mTranslation[2];
+  transform(x, y, z);
+  return Pose(x, y, z,
+    a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+    a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+    a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+    a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]);
+}
+
+Pose Pose::getInverse() const {
+  Pose inverse;
+  inverse.mRotation[0] = mRotation[0];
+  inverse.mRotation[1] = -mRotation[1];
+  inverse.mRotation[2] = -mRotation[2];
+  inverse.mRotation[3] = -mRotation[3];
+  double x = -mTranslation[0];
+  double y = -mTranslation[1];
+  double z = -mTranslation[2];
+  inverse.rotate(x, y, z);
+  inverse.mTranslation[0] = x;
+  inverse.mTranslation[1] = y;
+  inverse.mTranslation[2] = z;
+  return inverse;
+}
+
+Pose Pose::interpolate(const Pose& other, double alpha) const {
+  double q[4];
+  double dot = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    q[i] = other.mRotation[i];
+    dot += mRotation[i] * q[i];
+  }
+  if (dot < 0) {
+    for (size_t i = 0; i < 4; ++i)
+      q[i] = -q[i];
+    dot = -dot;
+  }
+  double a = 1 - alpha;
+  double b = alpha;
+  if (dot < 0.9995) {
+    const double theta = std::acos(dot);
+    const double sinTheta = std::sin(theta);
+    a = std::sin(a * theta) / sinTheta;
+    b = std::sin(b * theta) / sinTheta;
+  }
+  return Pose(
+    mTranslation[0] + alpha * (other.mTranslation[0] - mTranslation[0]),
+    mTranslation[1] + alpha * (other.mTranslation[1] - mTranslation[1]),
+    mTranslation[2] + alpha * (other.mTranslation[2] - mTranslation[2]),
+    a * mRotation[0] + b * q[0], a * mRotation[1] + b * q[1],
+    a * mRotation[2] + b * q[2], a * mRotation[3] + b * q[3]);
+}
+
+void Pose::transform(double& x, double& y, double& z) const {
+  rotate(x, y, z);
+  x += mTranslation[0];
+  y += mTranslation[1];
+  z += mTranslation[2];
+}
+
+void Pose::normalize() {
+  const double norm = std::sqrt(mRotation[0] * mRotation[0] +
+    mRotation[1] * mRotation[1] + mRotation[2] * mRotation[2] +
+    mRotation[3] * mRotation[3]);
+  for (size_t i = 0; i < 4; ++i)
+    mRotation[i] /= norm;
+}
+
+void Pose::rotate(double& x, double& y, double& z) const {
+  const double w = mRotation[0];
+  const double qx = mRotation[1];
+  const double qy = mRotation[2];
+  const double qz = mRotation[3];
+  const double tx = 2 * (qy * z - qz * y);
+  const double ty = 2 * (qz * x - qx * z);
+  const double tz = 2 * (qx * y - qy * x);
+  const double rx = x + w * tx + qy * tz - qz * ty;
+  const double ry = y + w * ty + qz * tx - qx * tz;
+  const double rz = z + w * tz + qx * ty - qy * tx;
+  x = rx;
+  y = ry;
+  z = rz;
+}
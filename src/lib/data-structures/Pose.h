@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file Pose.h
+    \brief This file defines the Pose class, which represents a rigid body
+           transformation
+  */
+
+#ifndef POSE_H
+#define POSE_H
+
+/** The class Pose represents a rigid body transformation as a translation and
+    a unit quaternion. Applied to a point, the rotation comes first.
+    \brief Rigid body transformation
+  */
+class Pose {
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs the identity
+  Pose();
+  /// Constructs from a translation and a quaternion (w, x, y, z)
+  Pose(double x, double y, double z, double qw, double qx, double qy, double
+    qz);
+  /// Copy constructor
+  Pose(const Pose& other);
+  /// Assignment operator
+  Pose& operator = (const Pose& other);
+  /// Destructor
+  ~Pose();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the translation
+  const double* getTranslation() const {
+    return mTranslation;
+  }
+  /// Returns the rotation as a quaternion (w, x, y, z)
+  const double* getRotation() const {
+    return mRotation;
+  }
+  /// Returns the row-major 3x4 matrix of the transformation
+  void getMatrix(float matrix[12]) const;
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Constructs from a translation and a rotation vector [rad]
+  static Pose fromRotationVector(double x, double y, double z, double rx,
+    double ry, double rz);
+  /// Composes with another transformation, the other one applied first
+  Pose operator * (const Pose& other) const;
+  /// Returns the inverse transformation
+  Pose getInverse() const;
+  /// Interpolates linearly the translation and spherically the rotation
+  Pose interpolate(const Pose& other, double alpha) const;
+  /// Transforms a point
+  void transform(double& x, double& y, double& z) const;
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Normalizes the quaternion
+  void normalize();
+  /// Rotates a vector
+  void rotate(double& x, double& y, double& z) const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Translation
+  double mTranslation[3];
+  /// Rotation as a quaternion (w, x, y, z)
+  double mRotation[4];
+  /** @}
+    */
+
+};
+
+#endif // POSE_H
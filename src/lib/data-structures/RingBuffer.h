@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file RingBuffer.h
+    \brief This file defines the RingBuffer class, which represents a bounded
+           single-producer/single-consumer queue without locks.
+  */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/** The class RingBuffer represents a bounded queue without locks for exactly
+    one producer thread and one consumer thread. Elements live in
+    preallocated slots which the producer fills in place. When the queue is
+    full, the oldest element is dropped and counted, as in SafeQueue. The
+    consumer claims an element before copying it out of its slot, and every
+    slot carries the sequence number of the next element it may receive: the
+    producer waits for a slot still being copied instead of overwriting it,
+    spinning briefly and then yielding the processor, so that the consumer
+    never waits but the producer is not lock-free.
+    \brief Single-producer/single-consumer queue without locks
+  */
+template <typename T> class RingBuffer {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  RingBuffer(const RingBuffer& other);
+  /// Assignment operator
+  RingBuffer& operator = (const RingBuffer& other);
+  /** @}
+    */
+
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs queue with capacity
+  RingBuffer(size_t capacity = 1024);
+  /// Destructor
+  ~RingBuffer();
+  /** @}
+    */
+
+  /** \name Accessors
+      @{
+    */
+  /// Returns the capacity of the queue
+  size_t getCapacity() const;
+  /// Returns the statistics about dropped elements
+  size_t getNumDroppedElements() const;
+  /// Check whether the queue is empty
+  bool isEmpty() const;
+  /// Get size of the queue
+  size_t getSize() const;
+  /** @}
+    */
+
+  /** \name Methods
+      @{
+    */
+  /// Returns the slot to be filled by the producer
+  T& beginEnqueue();
+  /// Publishes the slot filled by the producer
+  void endEnqueue();
+  /// Enqueue an element
+  void enqueue(const T& value);
+  /// Dequeue an element, returns false if the queue is empty
+  bool dequeue(T& value);
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Waits before polling a slot again, spinning then yielding
+  static void backoff(size_t& numPolls);
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Preallocated slots, one more than the capacity for the producer
+  std::vector<T> mSlots;
+  /// Sequence number of the next element of every slot
+  std::unique_ptr<std::atomic<uint64_t>[]> mSequences;
+  /// Capacity
+  size_t mCapacity;
+  /// Write position, only modified by the producer
+  alignas(64) std::atomic<uint64_t> mHead;
+  /// Read position, modified by the consumer and by the producer on drops
+  alignas(64) std::atomic<uint64_t> mTail;
+  /// Statistics about the dropped elements
+  alignas(64) std::atomic<size_t> mNumDroppedElements;
+  /** @}
+    */
+
+};
+
+#include "data-structures/RingBuffer.tpp"
+
+#endif // RINGBUFFER_H
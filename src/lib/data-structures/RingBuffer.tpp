@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <sched.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_t capacity) :
+    mCapacity(capacity),
+    mHead(0),
+    mTail(0),
+    mNumDroppedElements(0) {
+  if (!capacity || (capacity >= mSlots.max_size()))
+    throw BadArgumentException<size_t>(capacity,
+      "RingBuffer<T>::RingBuffer(): invalid capacity",
+      __FILE__, __LINE__);
+  mSlots.resize(capacity + 1);
+  mSequences.reset(new std::atomic<uint64_t>[mSlots.size()]);
+  for (size_t i = 0; i < mSlots.size(); ++i)
+    mSequences[i].store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+RingBuffer<T>::~RingBuffer() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+template <typename T>
+size_t RingBuffer<T>::getCapacity() const {
+  return mCapacity;
+}
+
+template <typename T>
+size_t RingBuffer<T>::getNumDroppedElements() const {
+  return mNumDroppedElements.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+bool RingBuffer<T>::isEmpty() const {
+  return mTail.load(std::memory_order_acquire) ==
+    mHead.load(std::memory_order_acquire);
+}
+
+template <typename T>
+size_t RingBuffer<T>::getSize() const {
+  const uint64_t tail = mTail.load(std::memory_order_acquire);
+  return mHead.load(std::memory_order_acquire) - tail;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+template <typename T>
+T& RingBuffer<T>::beginEnqueue() {
+  const uint64_t head = mHead.load(std::memory_order_relaxed);
+  const size_t slot = head % mSlots.size();
+  // The previous element of the slot is claimed, wait for its copy to end.
+  size_t numPolls = 0;
+  while (mSequences[slot].load(std::memory_order_acquire) != head)
+    backoff(numPolls);
+  return mSlots[slot];
+}
+
+template <typename T>
+void RingBuffer<T>::backoff(size_t& numPolls) {
+  // A copy in progress ends within a few spins, unless the consumer is
+  // descheduled: then give it the processor.
+  if (numPolls++ < 64) {
+#if defined(__i386__) || defined(__x86_64__)
+    _mm_pause();
+#endif
+  }
+  else
+    sched_yield();
+}
+
+template <typename T>
+void RingBuffer<T>::endEnqueue() {
+  const uint64_t head = mHead.load(std::memory_order_relaxed);
+  uint64_t tail = mTail.load(std::memory_order_acquire);
+  while (head + 1 - tail > mCapacity)
+    if (mTail.compare_exchange_weak(tail, tail + 1,
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+      mSequences[tail % mSlots.size()].store(tail + mSlots.size(),
+        std::memory_order_release);
+      mNumDroppedElements.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+  mHead.store(head + 1, std::memory_order_release);
+}
+
+template <typename T>
+void RingBuffer<T>::enqueue(const T& value) {
+  beginEnqueue() = value;
+  endEnqueue();
+}
+
+template <typename T>
+bool RingBuffer<T>::dequeue(T& value) {
+  uint64_t tail = mTail.load(std::memory_order_acquire);
+  while (tail != mHead.load(std::memory_order_acquire)) {
+    // A failed exchange means the producer dropped this element meanwhile:
+    // retry with the new tail. Once claimed, the slot is not overwritten
+    // before its sequence number moves on to the next element.
+    if (mTail.compare_exchange_strong(tail, tail + 1,
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+      const size_t slot = tail % mSlots.size();
+      value = mSlots[slot];
+      mSequences[slot].store(tail + mSlots.size(),
+        std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
@@ -28,6 +28,9 @@
 #include <limits>
 
 #include "base/Mutex.h"
+#include "base/Condition.h"
+#include "base/Timer.h"
+#include "base/Timestamp.h"
 
 /** The class SafeQueue represents a thread-safe queue.
     \brief Thread-safe queue
@@ -69,6 +72,8 @@ public:
   bool isEmpty() const;
   /// Get size of the queue
   size_t getSize() const;
+  /// Wait until the queue is not empty or the timeout in seconds expires
+  bool waitNotEmpty(double seconds = Timer::eternal()) const;
   /** @}
     */
 
@@ -79,10 +84,24 @@ public:
   void enqueue(const T& value);
   /// Dequeue an element
   T dequeue();
+  /// Dequeue an element, waiting at most the timeout in seconds
+  bool dequeue(T& value, double seconds);
+  /// Dequeue all elements at once, returns the number of elements
+  size_t dequeueAll(Container& values);
+  /// Accounts for an element dropped before reaching the queue
+  void drop();
   /** @}
     */
 
 protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Safely wait until the queue is not empty or the timeout expires
+  bool safeWaitNotEmpty(double seconds) const;
+  /** @}
+    */
+
   /** \name Protected members
     @{
     */
@@ -94,6 +113,8 @@ protected:
   size_t mNumDroppedElements;
   /// Mutex protecting the queue
   mutable Mutex mMutex;
+  /// Condition signaled when elements are enqueued
+  Condition mNotEmpty;
   /** @}
     */
 
@@ -30,7 +30,7 @@ SafeQueue<T>::SafeQueue(size_t capacity) :
 
 template <typename T>
 SafeQueue<T>::SafeQueue(const SafeQueue& other) {
-  Mutex::ScopedLock lock(mMutex);
+  Mutex::ScopedLock lock(other.mMutex);
   mQueue = other.mQueue;
   mCapacity = other.mCapacity;
   mNumDroppedElements = other.mNumDroppedElements;
@@ -85,6 +85,12 @@ size_t SafeQueue<T>::getSize() const {
   return mQueue.size();
 }
 
+template <typename T>
+bool SafeQueue<T>::waitNotEmpty(double seconds) const {
+  Mutex::ScopedLock lock(mMutex);
+  return safeWaitNotEmpty(seconds);
+}
+
 /******************************************************************************/
 /* Methods                                                                    */
 /******************************************************************************/
@@ -97,6 +103,7 @@ void SafeQueue<T>::enqueue(const T& value) {
     mQueue.pop_front();
     mNumDroppedElements++;
   }
+  mNotEmpty.signal(Condition::broadcast);
 }
 
 template <typename T>
@@ -108,3 +115,49 @@ T SafeQueue<T>::dequeue() {
   mQueue.pop_front();
   return front;
 }
+
+template <typename T>
+bool SafeQueue<T>::dequeue(T& value, double seconds) {
+  Mutex::ScopedLock lock(mMutex);
+  if (!safeWaitNotEmpty(seconds))
+    return false;
+  value = mQueue.front();
+  mQueue.pop_front();
+  return true;
+}
+
+template <typename T>
+size_t SafeQueue<T>::dequeueAll(Container& values) {
+  Mutex::ScopedLock lock(mMutex);
+  const size_t numElements = mQueue.size();
+  if (values.empty())
+    values.swap(mQueue);
+  else {
+    values.insert(values.end(), mQueue.begin(), mQueue.end());
+    mQueue.clear();
+  }
+  return numElements;
+}
+
+template <typename T>
+void SafeQueue<T>::drop() {
+  Mutex::ScopedLock lock(mMutex);
+  mNumDroppedElements++;
+}
+
+template <typename T>
+bool SafeQueue<T>::safeWaitNotEmpty(double seconds) const {
+  if (seconds == Timer::eternal()) {
+    while (mQueue.empty())
+      mNotEmpty.wait(mMutex);
+  }
+  else {
+    const Timestamp deadline(Timestamp::now() + seconds);
+    while (mQueue.empty()) {
+      const double left = deadline - Timestamp::now();
+      if ((left <= 0.0) || !mNotEmpty.wait(mMutex, left))
+        break;
+    }
+  }
+  return !mQueue.empty();
+}
@@ -18,6 +18,39 @@
 
 #include "data-structures/VdynePointCloud.h"
 
+#include <vector>
+
+#include "data-structures/BulkHeader.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+const char VdynePointCloud::mBulkMagic[4] = {'V', 'D', 'P', 'C'};
+
+namespace {
+
+/// Point record of the bulk format
+struct BulkPoint {
+  /// X coordinate
+  float mX;
+  /// Y coordinate
+  float mY;
+  /// Z coordinate
+  float mZ;
+  /// Intensity
+  uint8_t mIntensity;
+  /// Index of the laser
+  uint8_t mLaser;
+  /// Raw azimuth in encoder ticks
+  uint16_t mAzimuth;
+  /// Time offset to the cloud timestamp in seconds
+  float mTimeOffset;
+};
+
+}
+
 /******************************************************************************/
 /* Constructors and Destructor                                                */
 /******************************************************************************/
@@ -67,9 +100,58 @@ void VdynePointCloud::readBinary(std::istream& stream) {
   size_t numPoints;
   binaryStream >> mTimestamp >> mStartRotationAngle >> mEndRotationAngle
     >> numPoints;
+  mPoints.reserve(mPoints.size() + numPoints);
   for (size_t i = 0; i < numPoints; ++i) {
     Point3D point;
     point.readBinary(stream);
     mPoints.push_back(point);
   }
 }
+
+void VdynePointCloud::writeBulk(std::ostream& stream) const {
+  BulkHeader header(mBulkMagic, mBulkVersion);
+  header.mTimestamp = mTimestamp;
+  header.mStartRotationAngle = mStartRotationAngle;
+  header.mEndRotationAngle = mEndRotationAngle;
+  header.mRecordSize = sizeof(BulkPoint);
+  header.mNumRecords = mPoints.size();
+  header.write(stream);
+  std::vector<BulkPoint> records(mPoints.size());
+  for (size_t i = 0; i < mPoints.size(); ++i) {
+    records[i].mX = mPoints[i].mX;
+    records[i].mY = mPoints[i].mY;
+    records[i].mZ = mPoints[i].mZ;
+    records[i].mIntensity = mPoints[i].mIntensity;
+    records[i].mLaser = mPoints[i].mLaser;
+    records[i].mAzimuth = mPoints[i].mAzimuth;
+    records[i].mTimeOffset = mPoints[i].mTimeOffset;
+  }
+  if (!records.empty())
+    stream.write(reinterpret_cast<const char*>(&records[0]),
+      records.size() * sizeof(BulkPoint));
+}
+
+void VdynePointCloud::readBulk(std::istream& stream) {
+  BulkHeader header(mBulkMagic, mBulkVersion);
+  header.mRecordSize = sizeof(BulkPoint);
+  header.read(stream);
+  std::vector<BulkPoint> records(header.mNumRecords);
+  if (!records.empty())
+    stream.read(reinterpret_cast<char*>(&records[0]),
+      records.size() * sizeof(BulkPoint));
+  if (!stream)
+    throw IOException("VdynePointCloud::readBulk(): truncated points");
+  mTimestamp = header.mTimestamp;
+  mStartRotationAngle = header.mStartRotationAngle;
+  mEndRotationAngle = header.mEndRotationAngle;
+  mPoints.resize(records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    mPoints[i].mX = records[i].mX;
+    mPoints[i].mY = records[i].mY;
+    mPoints[i].mZ = records[i].mZ;
+    mPoints[i].mIntensity = records[i].mIntensity;
+    mPoints[i].mLaser = records[i].mLaser;
+    mPoints[i].mAzimuth = records[i].mAzimuth;
+    mPoints[i].mTimeOffset = records[i].mTimeOffset;
+  }
+}
@@ -32,7 +32,9 @@
 #include "base/BinaryStreamReader.h"
 #include "base/BinaryStreamWriter.h"
 
-/** The class VdynePointCloud represents a Velodyne point cloud.
+/** The class VdynePointCloud represents a Velodyne point cloud. Besides the
+    point-wise binary format, the bulk format writes a BulkHeader followed by
+    all the points as one block of packed records.
     \brief Velodyne point cloud
   */
 class VdynePointCloud :
@@ -52,12 +54,21 @@ public:
     float mZ;
     /// Intensity
     uint8_t mIntensity;
+    /// Index of the laser
+    uint8_t mLaser;
+    /// Raw azimuth in encoder ticks
+    uint16_t mAzimuth;
+    /// Time offset to the cloud timestamp in seconds
+    float mTimeOffset;
     /// Default constructor
     Point3D() :
         mX(0),
         mY(0),
         mZ(0),
-        mIntensity(0) {
+        mIntensity(0),
+        mLaser(0),
+        mAzimuth(0),
+        mTimeOffset(0) {
     }
     /// Copy constructor
     Point3D(const Point3D& other) :
@@ -65,7 +76,10 @@ public:
         mX(other.mX),
         mY(other.mY),
         mZ(other.mZ),
-        mIntensity(other.mIntensity) {
+        mIntensity(other.mIntensity),
+        mLaser(other.mLaser),
+        mAzimuth(other.mAzimuth),
+        mTimeOffset(other.mTimeOffset) {
     }
     /// Assignment operator
     Point3D& operator = (const Point3D& other) {
@@ -74,6 +88,9 @@ public:
         mY = other.mY;
         mZ = other.mZ;
         mIntensity = other.mIntensity;
+        mLaser = other.mLaser;
+        mAzimuth = other.mAzimuth;
+        mTimeOffset = other.mTimeOffset;
       }
       return *this;
     }
@@ -187,6 +204,10 @@ public:
   void insertPoint(const Point3D& point) {
     mPoints.push_back(point);
   }
+  /// Reserves memory for a number of points
+  void reserve(size_t numPoints) {
+    mPoints.reserve(numPoints);
+  }
   /// Clear the point cloud
   void clear() {
     mPoints.clear();
@@ -201,6 +222,20 @@ public:
   void writeBinary(std::ostream& stream) const;
   /// Reads from an input stream
   void readBinary(std::istream& stream);
+  /// Writes into an output stream in bulk format
+  void writeBulk(std::ostream& stream) const;
+  /// Reads from an input stream in bulk format, replacing the points
+  void readBulk(std::istream& stream);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Magic number of the bulk format
+  static const char mBulkMagic[4];
+  /// Version of the bulk format
+  static const uint32_t mBulkVersion = 1;
   /** @}
     */
 
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "data-structures/VdynePointCloudSoA.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+VdynePointCloudSoA::VdynePointCloudSoA(const VdynePointCloud& pointCloud) {
+  fromPointCloud(pointCloud);
+}
+
+VdynePointCloudSoA& VdynePointCloudSoA::operator =
+    (const VdynePointCloudSoA& other) {
+  if (this != &other) {
+    mTimestamp = other.mTimestamp;
+    mStartRotationAngle = other.mStartRotationAngle;
+    mEndRotationAngle = other.mEndRotationAngle;
+    mX = other.mX;
+    mY = other.mY;
+    mZ = other.mZ;
+    mIntensity = other.mIntensity;
+    mLaser = other.mLaser;
+    mAzimuth = other.mAzimuth;
+    mTimeOffset = other.mTimeOffset;
+  }
+  return *this;
+}
+
+/******************************************************************************/
+/* Streaming operations                                                       */
+/******************************************************************************/
+
+void VdynePointCloudSoA::read(std::istream& /*stream*/) {
+}
+
+void VdynePointCloudSoA::write(std::ostream& stream) const {
+  stream << "Timestamp: " << mTimestamp << std::endl
+    << "Start rotation: " << mStartRotationAngle << std::endl
+    << "End rotation: " << mEndRotationAngle << std::endl;
+  for (size_t i = 0; i < getSize(); ++i)
+    stream << mX[i] << " " << mY[i] << " " << mZ[i] << " " << mIntensity[i]
+      << std::endl;
+}
+
+void VdynePointCloudSoA::read(std::ifstream& /*stream*/) {
+}
+
+void VdynePointCloudSoA::write(std::ofstream& /*stream*/) const {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+void VdynePointCloudSoA::reserve(size_t numPoints) {
+  mX.reserve(numPoints);
+  mY.reserve(numPoints);
+  mZ.reserve(numPoints);
+  mIntensity.reserve(numPoints);
+  mLaser.reserve(numPoints);
+  mAzimuth.reserve(numPoints);
+  mTimeOffset.reserve(numPoints);
+}
+
+void VdynePointCloudSoA::resize(size_t numPoints) {
+  mX.resize(numPoints);
+  mY.resize(numPoints);
+  mZ.resize(numPoints);
+  mIntensity.resize(numPoints);
+  mLaser.resize(numPoints);
+  mAzimuth.resize(numPoints);
+  mTimeOffset.resize(numPoints);
+}
+
+void VdynePointCloudSoA::clear() {
+  mX.clear();
+  mY.clear();
+  mZ.clear();
+  mIntensity.clear();
+  mLaser.clear();
+  mAzimuth.clear();
+  mTimeOffset.clear();
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void VdynePointCloudSoA::fromPointCloud(const VdynePointCloud& pointCloud) {
+  mTimestamp = pointCloud.getTimestamp();
+  mStartRotationAngle = pointCloud.getStartRotationAngle();
+  mEndRotationAngle = pointCloud.getEndRotationAngle();
+  resize(pointCloud.getSize());
+  size_t i = 0;
+  for (auto it = pointCloud.getPointBegin(); it != pointCloud.getPointEnd();
+      ++it, ++i) {
+    mX[i] = it->mX;
+    mY[i] = it->mY;
+    mZ[i] = it->mZ;
+    mIntensity[i] = it->mIntensity;
+    mLaser[i] = it->mLaser;
+    mAzimuth[i] = it->mAzimuth;
+    mTimeOffset[i] = it->mTimeOffset;
+  }
+}
+
+void VdynePointCloudSoA::toPointCloud(VdynePointCloud& pointCloud) const {
+  pointCloud.clear();
+  pointCloud.setTimestamp(mTimestamp);
+  pointCloud.setStartRotationAngle(mStartRotationAngle);
+  pointCloud.setEndRotationAngle(mEndRotationAngle);
+  for (size_t i = 0; i < getSize(); ++i) {
+    VdynePointCloud::Point3D point;
+    point.mX = mX[i];
+    point.mY = mY[i];
+    point.mZ = mZ[i];
+    point.mIntensity = mIntensity[i];
+    point.mLaser = mLaser[i];
+    point.mAzimuth = mAzimuth[i];
+    point.mTimeOffset = mTimeOffset[i];
+    pointCloud.insertPoint(point);
+  }
+}
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file VdynePointCloudSoA.h
+    \brief This file defines the VdynePointCloudSoA class, which represents a
+           Velodyne point cloud in structure-of-arrays layout
+  */
+
+#ifndef VDYNEPOINTCLOUDSOA_H
+#define VDYNEPOINTCLOUDSOA_H
+
+#include <cstdint>
+
+#include <vector>
+
+#include "base/Serializable.h"
+#include "data-structures/AlignedAllocator.h"
+#include "data-structures/VdynePointCloud.h"
+
+/** The class VdynePointCloudSoA represents a Velodyne point cloud stored as
+    one aligned array per field, so that filters over the cloud vectorize.
+    Besides the coordinates and intensity, every point carries the index of
+    its laser, the raw azimuth in encoder ticks and its time offset to the
+    cloud timestamp in seconds.
+    \brief Velodyne point cloud in structure-of-arrays layout
+  */
+class VdynePointCloudSoA :
+  public Serializable {
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Coordinates and time offsets container type
+  typedef std::vector<float, AlignedAllocator<float> > FloatContainer;
+  /// Intensities and laser indices container type
+  typedef std::vector<uint8_t, AlignedAllocator<uint8_t> > ByteContainer;
+  /// Azimuths container type
+  typedef std::vector<uint16_t, AlignedAllocator<uint16_t> > ShortContainer;
+  /** @}
+    */
+
+  /** \name Constructors/Destructor
+    @{
+    */
+  /// Default constructor
+  VdynePointCloudSoA() :
+      mTimestamp(0),
+      mStartRotationAngle(0),
+      mEndRotationAngle(0) {}
+  /// Constructs from a point cloud
+  explicit VdynePointCloudSoA(const VdynePointCloud& pointCloud);
+  /// Copy constructor
+  VdynePointCloudSoA(const VdynePointCloudSoA& other) :
+      Serializable(),
+      mTimestamp(other.mTimestamp),
+      mStartRotationAngle(other.mStartRotationAngle),
+      mEndRotationAngle(other.mEndRotationAngle),
+      mX(other.mX),
+      mY(other.mY),
+      mZ(other.mZ),
+      mIntensity(other.mIntensity),
+      mLaser(other.mLaser),
+      mAzimuth(other.mAzimuth),
+      mTimeOffset(other.mTimeOffset) {}
+  /// Assignment operator
+  VdynePointCloudSoA& operator = (const VdynePointCloudSoA& other);
+  /// Destructor
+  ~VdynePointCloudSoA() {}
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the timestamp
+  int64_t getTimestamp() const {
+    return mTimestamp;
+  }
+  /// Sets the timestamp
+  void setTimestamp(int64_t timestamp) {
+    mTimestamp = timestamp;
+  }
+  /// Returns the starting rotational angle
+  float getStartRotationAngle() const {
+    return mStartRotationAngle;
+  }
+  /// Sets the starting rotational angle
+  void setStartRotationAngle(float angle) {
+    mStartRotationAngle = angle;
+  }
+  /// Returns the ending rotational angle
+  float getEndRotationAngle() const {
+    return mEndRotationAngle;
+  }
+  /// Sets the ending rotational angle
+  void setEndRotationAngle(float angle) {
+    mEndRotationAngle = angle;
+  }
+  /// Returns the x coordinates
+  const FloatContainer& getX() const {
+    return mX;
+  }
+  /// Returns the x coordinates
+  FloatContainer& getX() {
+    return mX;
+  }
+  /// Returns the y coordinates
+  const FloatContainer& getY() const {
+    return mY;
+  }
+  /// Returns the y coordinates
+  FloatContainer& getY() {
+    return mY;
+  }
+  /// Returns the z coordinates
+  const FloatContainer& getZ() const {
+    return mZ;
+  }
+  /// Returns the z coordinates
+  FloatContainer& getZ() {
+    return mZ;
+  }
+  /// Returns the intensities
+  const ByteContainer& getIntensity() const {
+    return mIntensity;
+  }
+  /// Returns the intensities
+  ByteContainer& getIntensity() {
+    return mIntensity;
+  }
+  /// Returns the laser indices
+  const ByteContainer& getLaser() const {
+    return mLaser;
+  }
+  /// Returns the laser indices
+  ByteContainer& getLaser() {
+    return mLaser;
+  }
+  /// Returns the azimuths in encoder ticks
+  const ShortContainer& getAzimuth() const {
+    return mAzimuth;
+  }
+  /// Returns the azimuths in encoder ticks
+  ShortContainer& getAzimuth() {
+    return mAzimuth;
+  }
+  /// Returns the time offsets in seconds
+  const FloatContainer& getTimeOffset() const {
+    return mTimeOffset;
+  }
+  /// Returns the time offsets in seconds
+  FloatContainer& getTimeOffset() {
+    return mTimeOffset;
+  }
+  /// Returns the size of the cloud
+  size_t getSize() const {
+    return mX.size();
+  }
+  /// Inserts a point into the point cloud
+  void insertPoint(float x, float y, float z, uint8_t intensity, uint8_t
+      laser = 0, uint16_t azimuth = 0, float timeOffset = 0) {
+    mX.push_back(x);
+    mY.push_back(y);
+    mZ.push_back(z);
+    mIntensity.push_back(intensity);
+    mLaser.push_back(laser);
+    mAzimuth.push_back(azimuth);
+    mTimeOffset.push_back(timeOffset);
+  }
+  /// Reserves memory for a number of points
+  void reserve(size_t numPoints);
+  /// Resizes the point cloud
+  void resize(size_t numPoints);
+  /// Clear the point cloud
+  void clear();
+  /** @}
+    */
+
+  /** \name Methods
+      @{
+    */
+  /// Copies a point cloud into this cloud
+  void fromPointCloud(const VdynePointCloud& pointCloud);
+  /// Copies this cloud into a point cloud
+  void toPointCloud(VdynePointCloud& pointCloud) const;
+  /** @}
+    */
+
+protected:
+  /** \name Stream methods
+    @{
+    */
+  /// Reads from standard input
+  virtual void read(std::istream& stream);
+  /// Writes to standard output
+  virtual void write(std::ostream& stream) const;
+  /// Reads from a file
+  virtual void read(std::ifstream& stream);
+  /// Writes to a file
+  virtual void write(std::ofstream& stream) const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Timestamp of the cloud
+  int64_t mTimestamp;
+  /// Start angle of the cloud
+  float mStartRotationAngle;
+  /// End angle of the cloud
+  float mEndRotationAngle;
+  /// X coordinates
+  FloatContainer mX;
+  /// Y coordinates
+  FloatContainer mY;
+  /// Z coordinates
+  FloatContainer mZ;
+  /// Intensities
+  ByteContainer mIntensity;
+  /// Laser indices
+  ByteContainer mLaser;
+  /// Azimuths in encoder ticks
+  ShortContainer mAzimuth;
+  /// Time offsets to the timestamp in seconds
+  FloatContainer mTimeOffset;
+  /** @}
+    */
+
+};
+
+#endif // VDYNEPOINTCLOUDSOA_H
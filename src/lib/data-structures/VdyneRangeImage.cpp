@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "data-structures/VdyneRangeImage.h"
+
+#include <algorithm>
+
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+VdyneRangeImage::VdyneRangeImage(size_t numRows, size_t numColumns, bool
+    hasPoints) :
+    mTimestamp(0),
+    mStartRotationAngle(0),
+    mEndRotationAngle(0),
+    mNumRows(numRows),
+    mNumColumns(numColumns),
+    mHasPoints(hasPoints),
+    mLaserRows(numRows),
+    mRange(numRows * numColumns, 0),
+    mIntensity(numRows * numColumns, 0) {
+  if (!numRows)
+    throw BadArgumentException<size_t>(numRows,
+      "VdyneRangeImage::VdyneRangeImage(): invalid number of rows",
+      __FILE__, __LINE__);
+  if (!numColumns || (numColumns > mNumAzimuthTicks))
+    throw BadArgumentException<size_t>(numColumns,
+      "VdyneRangeImage::VdyneRangeImage(): invalid number of columns",
+      __FILE__, __LINE__);
+  for (size_t i = 0; i < numRows; ++i)
+    mLaserRows[i] = i;
+  if (mHasPoints) {
+    mX.resize(numRows * numColumns, 0);
+    mY.resize(numRows * numColumns, 0);
+    mZ.resize(numRows * numColumns, 0);
+  }
+}
+
+VdyneRangeImage::VdyneRangeImage(const VdyneRangeImage& other) :
+    Serializable(),
+    mTimestamp(other.mTimestamp),
+    mStartRotationAngle(other.mStartRotationAngle),
+    mEndRotationAngle(other.mEndRotationAngle),
+    mNumRows(other.mNumRows),
+    mNumColumns(other.mNumColumns),
+    mHasPoints(other.mHasPoints),
+    mLaserRows(other.mLaserRows),
+    mRange(other.mRange),
+    mIntensity(other.mIntensity),
+    mX(other.mX),
+    mY(other.mY),
+    mZ(other.mZ) {
+}
+
+VdyneRangeImage& VdyneRangeImage::operator = (const VdyneRangeImage& other) {
+  if (this != &other) {
+    mTimestamp = other.mTimestamp;
+    mStartRotationAngle = other.mStartRotationAngle;
+    mEndRotationAngle = other.mEndRotationAngle;
+    mNumRows = other.mNumRows;
+    mNumColumns = other.mNumColumns;
+    mHasPoints = other.mHasPoints;
+    mLaserRows = other.mLaserRows;
+    mRange = other.mRange;
+    mIntensity = other.mIntensity;
+    mX = other.mX;
+    mY = other.mY;
+    mZ = other.mZ;
+  }
+  return *this;
+}
+
+/******************************************************************************/
+/* Streaming operations                                                       */
+/******************************************************************************/
+
+void VdyneRangeImage::read(std::istream& /*stream*/) {
+}
+
+void VdyneRangeImage::write(std::ostream& stream) const {
+  stream << "Timestamp: " << mTimestamp << std::endl
+    << "Start rotation: " << mStartRotationAngle << std::endl
+    << "End rotation: " << mEndRotationAngle << std::endl;
+  for (size_t i = 0; i < mNumRows; ++i) {
+    for (size_t j = 0; j < mNumColumns; ++j)
+      stream << getRange(i, j) << " ";
+    stream << std::endl;
+  }
+}
+
+void VdyneRangeImage::read(std::ifstream& /*stream*/) {
+}
+
+void VdyneRangeImage::write(std::ofstream& /*stream*/) const {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+void VdyneRangeImage::setLaserRows(const std::vector<size_t>& laserRows) {
+  for (auto it = laserRows.cbegin(); it != laserRows.cend(); ++it)
+    if (*it >= mNumRows)
+      throw OutOfBoundException<size_t>(*it,
+        "VdyneRangeImage::setLaserRows(): Out of bound",
+        __FILE__, __LINE__);
+  mLaserRows = laserRows;
+}
+
+void VdyneRangeImage::clear() {
+  std::fill(mRange.begin(), mRange.end(), 0);
+  std::fill(mIntensity.begin(), mIntensity.end(), 0);
+}
@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file VdyneRangeImage.h
+    \brief This file defines the VdyneRangeImage class, which represents a
+           Velodyne range image
+  */
+
+#ifndef VDYNERANGEIMAGE_H
+#define VDYNERANGEIMAGE_H
+
+#include <cstdint>
+
+#include <vector>
+
+#include "base/Serializable.h"
+#include "data-structures/AlignedAllocator.h"
+#include "exceptions/OutOfBoundException.h"
+
+/** The class VdyneRangeImage represents an organized Velodyne revolution: a
+    preallocated grid with one row per laser and one column per azimuth bin.
+    Each cell holds the range and intensity of a return and optionally its
+    3D point. Empty cells have a range of 0. Rows follow a laser-to-row
+    table, which defaults to the laser index and may cover fewer lasers than
+    the sensor has.
+    \brief Velodyne range image
+  */
+class VdyneRangeImage :
+  public Serializable {
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Ranges and coordinates container type
+  typedef std::vector<float, AlignedAllocator<float> > FloatContainer;
+  /// Intensities container type
+  typedef std::vector<uint8_t, AlignedAllocator<uint8_t> > ByteContainer;
+  /** @}
+    */
+
+  /** \name Constructors/Destructor
+    @{
+    */
+  /// Constructs image with number of rows, columns and whether to store 3D
+  VdyneRangeImage(size_t numRows = 64, size_t numColumns = 2048, bool
+    hasPoints = false);
+  /// Copy constructor
+  VdyneRangeImage(const VdyneRangeImage& other);
+  /// Assignment operator
+  VdyneRangeImage& operator = (const VdyneRangeImage& other);
+  /// Destructor
+  ~VdyneRangeImage() {}
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the timestamp
+  int64_t getTimestamp() const {
+    return mTimestamp;
+  }
+  /// Sets the timestamp
+  void setTimestamp(int64_t timestamp) {
+    mTimestamp = timestamp;
+  }
+  /// Returns the starting rotational angle
+  float getStartRotationAngle() const {
+    return mStartRotationAngle;
+  }
+  /// Sets the starting rotational angle
+  void setStartRotationAngle(float angle) {
+    mStartRotationAngle = angle;
+  }
+  /// Returns the ending rotational angle
+  float getEndRotationAngle() const {
+    return mEndRotationAngle;
+  }
+  /// Sets the ending rotational angle
+  void setEndRotationAngle(float angle) {
+    mEndRotationAngle = angle;
+  }
+  /// Returns the number of rows
+  size_t getNumRows() const {
+    return mNumRows;
+  }
+  /// Returns the number of columns
+  size_t getNumColumns() const {
+    return mNumColumns;
+  }
+  /// Returns whether the image stores 3D points
+  bool hasPoints() const {
+    return mHasPoints;
+  }
+  /// Returns the number of lasers of the laser-to-row table
+  size_t getNumLaserRows() const {
+    return mLaserRows.size();
+  }
+  /// Returns the row of a laser
+  size_t getLaserRow(size_t laser) const {
+#ifndef NDEBUG
+    if (laser >= mLaserRows.size())
+      throw OutOfBoundException<size_t>(laser,
+        "VdyneRangeImage::getLaserRow(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mLaserRows[laser];
+  }
+  /// Sets the row of every laser
+  void setLaserRows(const std::vector<size_t>& laserRows);
+  /// Returns the column of an azimuth in encoder ticks
+  size_t getAzimuthColumn(size_t azimuth) const {
+    return azimuth * mNumColumns / mNumAzimuthTicks % mNumColumns;
+  }
+  /// Returns the index of a cell
+  size_t getIndex(size_t row, size_t column) const {
+#ifndef NDEBUG
+    if (row >= mNumRows)
+      throw OutOfBoundException<size_t>(row,
+        "VdyneRangeImage::getIndex(): Out of bound",
+        __FILE__, __LINE__);
+    if (column >= mNumColumns)
+      throw OutOfBoundException<size_t>(column,
+        "VdyneRangeImage::getIndex(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return row * mNumColumns + column;
+  }
+  /// Returns the range of a cell, 0 if empty
+  float getRange(size_t row, size_t column) const {
+    return mRange[getIndex(row, column)];
+  }
+  /// Returns the intensity of a cell
+  uint8_t getIntensity(size_t row, size_t column) const {
+    return mIntensity[getIndex(row, column)];
+  }
+  /// Returns the ranges in row-major order
+  const FloatContainer& getRanges() const {
+    return mRange;
+  }
+  /// Returns the intensities in row-major order
+  const ByteContainer& getIntensities() const {
+    return mIntensity;
+  }
+  /// Returns the x coordinates in row-major order, if stored
+  const FloatContainer& getX() const {
+    return mX;
+  }
+  /// Returns the y coordinates in row-major order, if stored
+  const FloatContainer& getY() const {
+    return mY;
+  }
+  /// Returns the z coordinates in row-major order, if stored
+  const FloatContainer& getZ() const {
+    return mZ;
+  }
+  /// Sets a cell of the image
+  void setCell(size_t row, size_t column, float range, uint8_t intensity) {
+    const size_t index = getIndex(row, column);
+    mRange[index] = range;
+    mIntensity[index] = intensity;
+  }
+  /// Sets a cell of the image with its 3D point
+  void setCell(size_t row, size_t column, float range, uint8_t intensity,
+      float x, float y, float z) {
+    const size_t index = getIndex(row, column);
+    mRange[index] = range;
+    mIntensity[index] = intensity;
+    if (mHasPoints) {
+      mX[index] = x;
+      mY[index] = y;
+      mZ[index] = z;
+    }
+  }
+  /// Empties all the cells
+  void clear();
+  /** @}
+    */
+
+  /** \name Constants
+    @{
+    */
+  /// Number of encoder ticks per revolution
+  static const size_t mNumAzimuthTicks = 36000;
+  /** @}
+    */
+
+protected:
+  /** \name Stream methods
+    @{
+    */
+  /// Reads from standard input
+  virtual void read(std::istream& stream);
+  /// Writes to standard output
+  virtual void write(std::ostream& stream) const;
+  /// Reads from a file
+  virtual void read(std::ifstream& stream);
+  /// Writes to a file
+  virtual void write(std::ofstream& stream) const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Timestamp of the image
+  int64_t mTimestamp;
+  /// Start angle of the image
+  float mStartRotationAngle;
+  /// End angle of the image
+  float mEndRotationAngle;
+  /// Number of rows
+  size_t mNumRows;
+  /// Number of columns
+  size_t mNumColumns;
+  /// Whether 3D points are stored
+  bool mHasPoints;
+  /// Row of every laser
+  std::vector<size_t> mLaserRows;
+  /// Ranges
+  FloatContainer mRange;
+  /// Intensities
+  ByteContainer mIntensity;
+  /// X coordinates
+  FloatContainer mX;
+  /// Y coordinates
+  FloatContainer mY;
+  /// Z coordinates
+  FloatContainer mZ;
+  /** @}
+    */
+
+};
+
+#endif // VDYNERANGEIMAGE_H
@@ -18,6 +18,35 @@
 
 #include "data-structures/VdyneScanCloud.h"
 
+#include <vector>
+
+#include "data-structures/BulkHeader.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+const char VdyneScanCloud::mBulkMagic[4] = {'V', 'D', 'S', 'C'};
+
+namespace {
+
+/// Scan record of the bulk format
+struct BulkScan {
+  /// Range
+  float mRange;
+  /// Heading angle
+  float mHeading;
+  /// Pitch angle
+  float mPitch;
+  /// Intensity
+  uint8_t mIntensity;
+  /// Padding to the alignment of the record
+  uint8_t mReserved[3];
+};
+
+}
+
 /******************************************************************************/
 /* Constructors and Destructor                                                */
 /******************************************************************************/
@@ -67,9 +96,55 @@ void VdyneScanCloud::readBinary(std::istream& stream) {
   size_t numScans;
   binaryStream >> mTimestamp >> mStartRotationAngle >> mEndRotationAngle
     >> numScans;
+  mScans.reserve(mScans.size() + numScans);
   for (size_t i = 0; i < numScans; ++i) {
     Scan scan;
     scan.readBinary(stream);
     mScans.push_back(scan);
   }
 }
+
+void VdyneScanCloud::writeBulk(std::ostream& stream) const {
+  BulkHeader header(mBulkMagic, mBulkVersion);
+  header.mTimestamp = mTimestamp;
+  header.mStartRotationAngle = mStartRotationAngle;
+  header.mEndRotationAngle = mEndRotationAngle;
+  header.mRecordSize = sizeof(BulkScan);
+  header.mNumRecords = mScans.size();
+  header.write(stream);
+  std::vector<BulkScan> records(mScans.size());
+  for (size_t i = 0; i < mScans.size(); ++i) {
+    records[i].mRange = mScans[i].mRange;
+    records[i].mHeading = mScans[i].mHeading;
+    records[i].mPitch = mScans[i].mPitch;
+    records[i].mIntensity = mScans[i].mIntensity;
+    records[i].mReserved[0] = 0;
+    records[i].mReserved[1] = 0;
+    records[i].mReserved[2] = 0;
+  }
+  if (!records.empty())
+    stream.write(reinterpret_cast<const char*>(&records[0]),
+      records.size() * sizeof(BulkScan));
+}
+
+void VdyneScanCloud::readBulk(std::istream& stream) {
+  BulkHeader header(mBulkMagic, mBulkVersion);
+  header.mRecordSize = sizeof(BulkScan);
+  header.read(stream);
+  std::vector<BulkScan> records(header.mNumRecords);
+  if (!records.empty())
+    stream.read(reinterpret_cast<char*>(&records[0]),
+      records.size() * sizeof(BulkScan));
+  if (!stream)
+    throw IOException("VdyneScanCloud::readBulk(): truncated scans");
+  mTimestamp = header.mTimestamp;
+  mStartRotationAngle = header.mStartRotationAngle;
+  mEndRotationAngle = header.mEndRotationAngle;
+  mScans.resize(records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    mScans[i].mRange = records[i].mRange;
+    mScans[i].mHeading = records[i].mHeading;
+    mScans[i].mPitch = records[i].mPitch;
+    mScans[i].mIntensity = records[i].mIntensity;
+  }
+}
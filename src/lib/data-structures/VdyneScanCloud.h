@@ -32,7 +32,9 @@
 #include "base/BinaryStreamReader.h"
 #include "base/BinaryStreamWriter.h"
 
-/** The class VdyneScanCloud represents a Velodyne scan cloud.
+/** The class VdyneScanCloud represents a Velodyne scan cloud. Besides the
+    scan-wise binary format, the bulk format writes a BulkHeader followed by
+    all the scans as one block of packed records.
     \brief Velodyne scan cloud
   */
 class VdyneScanCloud :
@@ -188,6 +190,10 @@ public:
   void insertScan(const Scan& scan) {
     mScans.push_back(scan);
   }
+  /// Reserves memory for a number of scans
+  void reserve(size_t numScans) {
+    mScans.reserve(numScans);
+  }
   /// Clear the scan cloud
   void clear() {
     mScans.clear();
@@ -202,6 +208,20 @@ public:
   void writeBinary(std::ostream& stream) const;
   /// Reads from an input stream
   void readBinary(std::istream& stream);
+  /// Writes into an output stream in bulk format
+  void writeBulk(std::ostream& stream) const;
+  /// Reads from an input stream in bulk format, replacing the scans
+  void readBulk(std::istream& stream);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Magic number of the bulk format
+  static const char mBulkMagic[4];
+  /// Version of the bulk format
+  static const uint32_t mBulkVersion = 1;
   /** @}
     */
 
@@ -25,17 +25,29 @@
 #define ACQUISITIONTHREAD_H
 
 #include <memory>
+#include <vector>
 
 #include "base/Thread.h"
 #include "data-structures/SafeQueue.h"
+#include "data-structures/RingBuffer.h"
+#include "data-structures/ObjectPool.h"
 
 class UDPConnectionServer;
 
 /** The class AcquisitionThread represents an interface for acquiring Velodyne
-    packets using a thread.
+    packets using a thread. The acquisition buffer is either a SafeQueue of
+    shared packets (default) or a RingBuffer of preallocated packets, which
+    requires an explicit buffer size. Shared packets are recycled through an
+    ObjectPool of at most the pool size, so that acquisition does not
+    allocate in steady state. When all pooled packets are in use, e.g.,
+    queued behind a slow consumer, new packets are dropped, and counted both
+    as pool exhaustions and as dropped elements of the queue. Hence, even an
+    unbounded queue drops the newest packets beyond the pool size instead of
+    growing. The pool is only built for a SafeQueue.
     \brief Velodyne acquisition thread
   */
-template <typename P> class AcquisitionThread :
+template <typename P, typename B = SafeQueue<std::shared_ptr<P> > >
+    class AcquisitionThread :
   public Thread {
   /** \name Private constructors
     @{
@@ -51,16 +63,18 @@ public:
   /** \name Types definitions
     @{
     */
-  typedef SafeQueue<std::shared_ptr<P> > Buffer;
+  /// Acquisition buffer type
+  typedef B Buffer;
   /** @}
     */
 
   /** \name Constructors/Destructor
     @{
     */
-  /// Constructs thread with UDP connection and buffer size
+  /// Constructs thread with UDP connection, buffer, batch and pool sizes
   AcquisitionThread(UDPConnectionServer& connection, size_t bufferSize =
-    std::numeric_limits<size_t>::max());
+    std::numeric_limits<size_t>::max(), size_t batchSize = 1,
+    size_t poolSize = 1024);
    /// Destructor
   ~AcquisitionThread();
   /** @}
@@ -73,6 +87,10 @@ public:
   const Buffer& getBuffer() const;
   /// Access the thread's acquisition queue
   Buffer& getBuffer();
+  /// Returns the maximum number of packets read per wakeup
+  size_t getBatchSize() const;
+  /// Returns the pool of shared packets, 0 for a RingBuffer
+  const ObjectPool<P>* getPool() const;
   /** @}
     */
 
@@ -82,6 +100,21 @@ protected:
     */
   /// Do computational processing
   virtual void process();
+  /// Read a single packet from the connection into a queue
+  void readPacket(SafeQueue<std::shared_ptr<P> >& buffer);
+  /// Read a single packet from the connection into a ring buffer
+  void readPacket(RingBuffer<P>& buffer);
+  /// Read a batch of packets from the connection into a queue
+  void readBatch(SafeQueue<std::shared_ptr<P> >& buffer);
+  /// Read a batch of packets from the connection into a ring buffer
+  void readBatch(RingBuffer<P>& buffer);
+  /// Read a batch of raw packets from the connection
+  size_t readRawBatch();
+  /// Creates the pool of shared packets of a queue
+  static ObjectPool<P>* createPool(SafeQueue<std::shared_ptr<P> >* buffer,
+    size_t poolSize);
+  /// Creates no pool for a ring buffer
+  static ObjectPool<P>* createPool(RingBuffer<P>* buffer, size_t poolSize);
   /** @}
     */
 
@@ -92,6 +125,16 @@ protected:
   UDPConnectionServer& mConnection;
   /// Buffer for acquisition
   Buffer mBuffer;
+  /// Pool of shared packets
+  std::unique_ptr<ObjectPool<P> > mPool;
+  /// Maximum number of packets read per wakeup
+  size_t mBatchSize;
+  /// Raw receive buffer for batched reads
+  std::vector<char> mBatchBuffer;
+  /// Datagram sizes for batched reads
+  std::vector<size_t> mBatchNumBytes;
+  /// Datagram timestamps for batched reads
+  std::vector<int64_t> mBatchTimestamps;
   /** @}
     */
 
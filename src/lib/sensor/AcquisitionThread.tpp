@@ -24,42 +24,73 @@
 /* Constructors and Destructor                                                */
 /******************************************************************************/
 
-template <typename P>
-AcquisitionThread<P>::AcquisitionThread(UDPConnectionServer& connection, size_t
-    bufferSize) :
+template <typename P, typename B>
+AcquisitionThread<P, B>::AcquisitionThread(UDPConnectionServer& connection,
+    size_t bufferSize, size_t batchSize, size_t poolSize) :
     mConnection(connection),
-    mBuffer(bufferSize) {
+    mBuffer(bufferSize),
+    mPool(createPool(static_cast<B*>(0), poolSize)),
+    mBatchSize(batchSize ? batchSize : 1) {
+  if (mBatchSize > 1) {
+    mBatchBuffer.resize(mBatchSize * P::mPacketSize);
+    mBatchNumBytes.resize(mBatchSize);
+    mBatchTimestamps.resize(mBatchSize);
+  }
 }
 
-template <typename P>
-AcquisitionThread<P>::~AcquisitionThread() {
+template <typename P, typename B>
+AcquisitionThread<P, B>::~AcquisitionThread() {
 }
 
 /******************************************************************************/
 /* Accessors                                                                  */
 /******************************************************************************/
 
-template <typename P>
-const typename AcquisitionThread<P>::Buffer& AcquisitionThread<P>::getBuffer()
-    const {
+template <typename P, typename B>
+const typename AcquisitionThread<P, B>::Buffer&
+    AcquisitionThread<P, B>::getBuffer() const {
   return mBuffer;
 }
 
-template <typename P>
-typename AcquisitionThread<P>::Buffer& AcquisitionThread<P>::getBuffer() {
+template <typename P, typename B>
+typename AcquisitionThread<P, B>::Buffer&
+    AcquisitionThread<P, B>::getBuffer() {
   return mBuffer;
 }
 
+template <typename P, typename B>
+size_t AcquisitionThread<P, B>::getBatchSize() const {
+  return mBatchSize;
+}
+
+template <typename P, typename B>
+const ObjectPool<P>* AcquisitionThread<P, B>::getPool() const {
+  return mPool.get();
+}
+
 /******************************************************************************/
 /* Methods                                                                    */
 /******************************************************************************/
 
-template <typename P>
-void AcquisitionThread<P>::process() {
-  std::shared_ptr<P> p(new P());
+template <typename P, typename B>
+ObjectPool<P>* AcquisitionThread<P, B>::createPool(SafeQueue<std::shared_ptr<
+    P> >* /*buffer*/, size_t poolSize) {
+  return new ObjectPool<P>(poolSize, poolSize);
+}
+
+template <typename P, typename B>
+ObjectPool<P>* AcquisitionThread<P, B>::createPool(RingBuffer<P>*
+    /*buffer*/, size_t /*poolSize*/) {
+  return 0;
+}
+
+template <typename P, typename B>
+void AcquisitionThread<P, B>::process() {
   try {
-    p->readBinary(mConnection);
-    mBuffer.enqueue(p);
+    if (mBatchSize > 1)
+      readBatch(mBuffer);
+    else
+      readPacket(mBuffer);
   }
   catch (IOException& e) {
     std::cerr << e.what() << std::endl;
@@ -68,3 +99,58 @@ void AcquisitionThread<P>::process() {
     std::cerr << e.what() << std::endl;
   }
 }
+
+template <typename P, typename B>
+void AcquisitionThread<P, B>::readPacket(SafeQueue<std::shared_ptr<P> >&
+    buffer) {
+  std::shared_ptr<P> p = mPool->acquire();
+  if (!p) {
+    P droppedPacket;
+    droppedPacket.readBinary(mConnection);
+    buffer.drop();
+    return;
+  }
+  p->readBinary(mConnection);
+  buffer.enqueue(p);
+}
+
+template <typename P, typename B>
+void AcquisitionThread<P, B>::readPacket(RingBuffer<P>& buffer) {
+  buffer.beginEnqueue().readBinary(mConnection);
+  buffer.endEnqueue();
+}
+
+template <typename P, typename B>
+size_t AcquisitionThread<P, B>::readRawBatch() {
+  return mConnection.readBatch(&mBatchBuffer[0], P::mPacketSize, mBatchSize,
+    &mBatchNumBytes[0], &mBatchTimestamps[0]);
+}
+
+template <typename P, typename B>
+void AcquisitionThread<P, B>::readBatch(SafeQueue<std::shared_ptr<P> >&
+    buffer) {
+  const size_t numPackets = readRawBatch();
+  for (size_t i = 0; i < numPackets; ++i) {
+    if (mBatchNumBytes[i] != P::mPacketSize)
+      continue;
+    std::shared_ptr<P> p = mPool->acquire();
+    if (!p) {
+      buffer.drop();
+      continue;
+    }
+    p->readBinary(&mBatchBuffer[i * P::mPacketSize], mBatchTimestamps[i]);
+    buffer.enqueue(p);
+  }
+}
+
+template <typename P, typename B>
+void AcquisitionThread<P, B>::readBatch(RingBuffer<P>& buffer) {
+  const size_t numPackets = readRawBatch();
+  for (size_t i = 0; i < numPackets; ++i) {
+    if (mBatchNumBytes[i] != P::mPacketSize)
+      continue;
+    buffer.beginEnqueue().readBinary(&mBatchBuffer[i * P::mPacketSize],
+      mBatchTimestamps[i]);
+    buffer.endEnqueue();
+  }
+}
@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file BatchConverter.h
+    \brief This file defines the BatchConverter class, which converts log files
+           of Velodyne data packets with a pool of worker threads
+  */
+
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/Thread.h"
+#include "base/Mutex.h"
+#include "base/Condition.h"
+#include "sensor/Calibration.h"
+#include "sensor/Converter.h"
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/SensorTraits.h"
+#include "data-structures/SafeQueue.h"
+#include "data-structures/ObjectPool.h"
+#include "data-structures/VdynePointCloud.h"
+#include "data-structures/VdyneScanCloud.h"
+
+/** The class BatchConverter converts a log file of Velodyne data packets into
+    one point or scan cloud per packet, written to an output stream by a
+    formatter, in text by default. The log is read in jobs of consecutive
+    packets, which a pool of worker threads converts and formats in parallel,
+    while the calling thread writes the finished jobs in log order. Logs are
+    read through a PacketLogReader, raw or compressed, or from a stream of
+    raw records. The cloud type C is VdynePointCloud or VdyneScanCloud and S
+    is the sensor model, by default the model of the calibration. Packet
+    timestamps come from the timestamp source of the converter. An exception
+    raised while converting a job is rethrown by convert() once the jobs
+    before it are written.
+    \brief Parallel conversion of Velodyne log files
+  */
+template <typename C, typename S = AutoSensor> class BatchConverter {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  BatchConverter(const BatchConverter& other);
+  /// Assignment operator
+  BatchConverter& operator = (const BatchConverter& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Formatter writing a cloud to a stream
+  typedef void (*Formatter)(const C& cloud, std::ostream& stream);
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs the converter from a calibration and the pool parameters
+  BatchConverter(const Calibration& calibration, Formatter formatter =
+    &BatchConverter::writeText, size_t numWorkers = 0, size_t packetsPerJob =
+    1024, float minDistance = Converter::mMinDistance, float maxDistance =
+    Converter::mMaxDistance);
+  /// Destructor
+  ~BatchConverter();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the number of worker threads
+  size_t getNumWorkers() const;
+  /// Returns the number of packets per job
+  size_t getPacketsPerJob() const;
+  /// Returns the source of the packet timestamps
+  Converter::TimestampSource getTimestampSource() const;
+  /// Sets the source of the packet timestamps
+  void setTimestampSource(Converter::TimestampSource source);
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Converts a log file into an output stream, returns the packets number
+  size_t convert(const PacketLogReader& logReader, std::ostream& outStream);
+  /// Converts a raw log stream into an output stream, returns the packets
+  /// number
+  size_t convert(std::istream& logStream, std::ostream& outStream);
+  /// Writes a cloud in text
+  static void writeText(const C& cloud, std::ostream& stream);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Size of a packet record in a log file
+  static const size_t mRecordSize = sizeof(int64_t) + DataPacket::mPacketSize;
+  /** @}
+    */
+
+protected:
+  /** \name Protected types definitions
+    @{
+    */
+  /// The struct Job represents a range of packets to convert.
+  struct Job {
+    /// Packet records read from the log
+    std::vector<char> mInput;
+    /// Number of packets
+    size_t mNumPackets;
+    /// Formatted clouds
+    std::string mOutput;
+    /// Completion flag
+    bool mDone;
+    /// Exception raised by the conversion, if any
+    std::exception_ptr mError;
+    /// Default constructor
+    Job() :
+        mNumPackets(0),
+        mDone(false) {}
+  };
+  /// The class Worker converts the jobs of the converter.
+  class Worker :
+    public Thread {
+  public:
+    /// Constructs the worker for a converter
+    Worker(BatchConverter& converter) :
+        mConverter(converter) {}
+  protected:
+    /// Converts the next job
+    virtual void process();
+    /// Converter owning the worker
+    BatchConverter& mConverter;
+  };
+  /** @}
+    */
+
+  /** \name Protected methods
+    @{
+    */
+  /// Returns the number of online processors
+  static size_t getNumProcessors();
+  /// Converts a log into an output stream, returns the packets number
+  template <typename L> size_t convertLog(L& log, std::ostream& outStream);
+  /// Reads the job starting at a packet, returns false at the end of the log
+  bool readJob(const PacketLogReader& logReader, size_t packetIdx, Job& job)
+    const;
+  /// Reads the job starting at a packet, returns false at the end of the log
+  bool readJob(std::istream& logStream, size_t packetIdx, Job& job) const;
+  /// Converts a job
+  void processJob(Job& job) const;
+  /// Converts a packet into a point cloud
+  void convert(const DataPacketView& dataPacket, VdynePointCloud& pointCloud)
+    const;
+  /// Converts a packet into a scan cloud
+  void convert(const DataPacketView& dataPacket, VdyneScanCloud& scanCloud)
+    const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Calibration of the sensor
+  const Calibration& mCalibration;
+  /// Formatter of the clouds
+  Formatter mFormatter;
+  /// Number of packets per job
+  size_t mPacketsPerJob;
+  /// Minimum distance of the points
+  float mMinDistance;
+  /// Maximum distance of the points
+  float mMaxDistance;
+  /// Source of the packet timestamps
+  Converter::TimestampSource mTimestampSource;
+  /// Jobs waiting for a worker
+  SafeQueue<std::shared_ptr<Job> > mJobs;
+  /// Recycled jobs
+  ObjectPool<Job> mPool;
+  /// Mutex protecting the completion flags
+  Mutex mMutex;
+  /// Signaled when a job is done
+  Condition mJobDone;
+  /// Worker threads
+  std::vector<std::shared_ptr<Worker> > mWorkers;
+  /** @}
+    */
+
+};
+
+#include "sensor/BatchConverter.tpp"
+
+#endif // BATCHCONVERTER_H
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include <cstring>
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "sensor/PacketCodec.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+template <typename C, typename S>
+BatchConverter<C, S>::BatchConverter(const Calibration& calibration,
+    Formatter formatter, size_t numWorkers, size_t packetsPerJob, float
+    minDistance, float maxDistance) :
+    mCalibration(calibration),
+    mFormatter(formatter),
+    mPacketsPerJob(packetsPerJob ? packetsPerJob : 1),
+    mMinDistance(minDistance),
+    mMaxDistance(maxDistance),
+    mTimestampSource(Converter::host),
+    mPool(2 * (numWorkers ? numWorkers : getNumProcessors())) {
+  if (!numWorkers)
+    numWorkers = getNumProcessors();
+  for (size_t i = 0; i < numWorkers; ++i) {
+    mWorkers.push_back(std::shared_ptr<Worker>(new Worker(*this)));
+    mWorkers.back()->start();
+  }
+}
+
+template <typename C, typename S>
+BatchConverter<C, S>::~BatchConverter() {
+  for (size_t i = 0; i < mWorkers.size(); ++i)
+    mWorkers[i]->interrupt();
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+template <typename C, typename S>
+size_t BatchConverter<C, S>::getNumWorkers() const {
+  return mWorkers.size();
+}
+
+template <typename C, typename S>
+size_t BatchConverter<C, S>::getPacketsPerJob() const {
+  return mPacketsPerJob;
+}
+
+template <typename C, typename S>
+Converter::TimestampSource BatchConverter<C, S>::getTimestampSource() const {
+  return mTimestampSource;
+}
+
+template <typename C, typename S>
+void BatchConverter<C, S>::setTimestampSource(Converter::TimestampSource
+    source) {
+  mTimestampSource = source;
+}
+
+template <typename C, typename S>
+size_t BatchConverter<C, S>::getNumProcessors() {
+  const long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+  return (numProcessors > 0) ? numProcessors : 1;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+template <typename C, typename S>
+void BatchConverter<C, S>::Worker::process() {
+  std::shared_ptr<Job> job;
+  if (!mConverter.mJobs.dequeue(job, 0.1))
+    return;
+  try {
+    mConverter.processJob(*job);
+  }
+  catch (std::exception& /*e*/) {
+    job->mError = std::current_exception();
+  }
+  Mutex::ScopedLock lock(mConverter.mMutex);
+  job->mDone = true;
+  mConverter.mJobDone.signal(Condition::broadcast);
+}
+
+template <typename C, typename S>
+void BatchConverter<C, S>::processJob(Job& job) const {
+  std::ostringstream stream;
+  C cloud;
+  for (size_t i = 0; i < job.mNumPackets; ++i) {
+    const char* record = &job.mInput[i * mRecordSize];
+    int64_t timestamp;
+    memcpy(&timestamp, record, sizeof(timestamp));
+    cloud.clear();
+    convert(DataPacketView(reinterpret_cast<const uint8_t*>(record +
+      sizeof(timestamp)), timestamp), cloud);
+    mFormatter(cloud, stream);
+  }
+  job.mOutput = stream.str();
+}
+
+template <typename C, typename S>
+void BatchConverter<C, S>::writeText(const C& cloud, std::ostream& stream) {
+  stream << cloud;
+}
+
+template <typename C, typename S>
+void BatchConverter<C, S>::convert(const DataPacketView& dataPacket,
+    VdynePointCloud& pointCloud) const {
+  Converter::toPointCloud<S>(dataPacket, mCalibration, pointCloud,
+    mMinDistance, mMaxDistance, mTimestampSource);
+}
+
+template <typename C, typename S>
+void BatchConverter<C, S>::convert(const DataPacketView& dataPacket,
+    VdyneScanCloud& scanCloud) const {
+  Converter::toScanCloud<S>(dataPacket, mCalibration, scanCloud,
+    mMinDistance, mMaxDistance, mTimestampSource);
+}
+
+template <typename C, typename S>
+bool BatchConverter<C, S>::readJob(const PacketLogReader& logReader, size_t
+    packetIdx, Job& job) const {
+  job.mNumPackets = std::min(mPacketsPerJob, logReader.getNumPackets() -
+    packetIdx);
+  job.mInput.resize(job.mNumPackets * mRecordSize);
+  for (size_t i = 0; i < job.mNumPackets; ++i) {
+    const DataPacketView dataPacket = logReader.getPacket(packetIdx + i);
+    const int64_t timestamp = dataPacket.getTimestamp();
+    char* record = &job.mInput[i * mRecordSize];
+    memcpy(record, &timestamp, sizeof(timestamp));
+    memcpy(record + sizeof(timestamp), &dataPacket.getRawPacket(),
+      DataPacket::mPacketSize);
+  }
+  return packetIdx + job.mNumPackets < logReader.getNumPackets();
+}
+
+template <typename C, typename S>
+bool BatchConverter<C, S>::readJob(std::istream& logStream, size_t
+    packetIdx, Job& job) const {
+  job.mInput.resize(mPacketsPerJob * mRecordSize);
+  logStream.read(&job.mInput[0], job.mInput.size());
+  const size_t numBytes = logStream.gcount();
+  if (!packetIdx && PacketCodec::isCompressed(reinterpret_cast<const
+      uint8_t*>(&job.mInput[0]), numBytes))
+    throw IOException("BatchConverter::convert(): compressed log stream, "
+      "read it through a PacketLogReader");
+  job.mNumPackets = numBytes / mRecordSize;
+  return logStream.good();
+}
+
+template <typename C, typename S>
+size_t BatchConverter<C, S>::convert(const PacketLogReader& logReader,
+    std::ostream& outStream) {
+  return convertLog(logReader, outStream);
+}
+
+template <typename C, typename S>
+size_t BatchConverter<C, S>::convert(std::istream& logStream, std::ostream&
+    outStream) {
+  return convertLog(logStream, outStream);
+}
+
+template <typename C, typename S>
+template <typename L>
+size_t BatchConverter<C, S>::convertLog(L& log, std::ostream& outStream) {
+  const size_t maxPendingJobs = 2 * mWorkers.size();
+  std::deque<std::shared_ptr<Job> > pendingJobs;
+  size_t numPackets = 0;
+  bool endOfLog = false;
+  while (!endOfLog || !pendingJobs.empty()) {
+    while (!endOfLog && (pendingJobs.size() < maxPendingJobs)) {
+      std::shared_ptr<Job> job = mPool.acquire();
+      endOfLog = !readJob(log, numPackets, *job);
+      if (!job->mNumPackets)
+        break;
+      numPackets += job->mNumPackets;
+      job->mDone = false;
+      job->mError = std::exception_ptr();
+      pendingJobs.push_back(job);
+      mJobs.enqueue(job);
+    }
+    if (pendingJobs.empty())
+      break;
+    std::shared_ptr<Job> job = pendingJobs.front();
+    pendingJobs.pop_front();
+    {
+      Mutex::ScopedLock lock(mMutex);
+      while (!job->mDone)
+        mJobDone.wait(mMutex);
+    }
+    if (job->mError)
+      std::rethrow_exception(job->mError);
+    outStream.write(job->mOutput.data(), job->mOutput.size());
+  }
+  return numPackets;
+}
@@ -18,40 +18,213 @@
 
 #include "sensor/Calibration.h"
 
-#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
 
 #include "exceptions/IOException.h"
+#include "exceptions/SystemException.h"
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+const float Calibration::mFocalDistanceScale = 65535.0f;
+
+const float Calibration::mFocalDistanceNorm = 13100.0f;
+
+const float Calibration::mFocalOffsetScale = 256.0f;
+
+const float Calibration::mDistCorrXNear = 2.4f;
+
+const float Calibration::mDistCorrYNear = 1.93f;
+
+const float Calibration::mDistCorrFar = 25.04f;
+
+const char Calibration::mBinaryMagic[8] = {'V', 'D', 'Y', 'N', 'C', 'A', 'L',
+  'B'};
+
+Calibration::Table Calibration::* const
+    Calibration::mTableMembers[mNumTables] = {
+  &Calibration::mRotCorr,
+  &Calibration::mSinRotCorr,
+  &Calibration::mCosRotCorr,
+  &Calibration::mVertCorr,
+  &Calibration::mSinVertCorr,
+  &Calibration::mCosVertCorr,
+  &Calibration::mDistCorr,
+  &Calibration::mVertOffsCorr,
+  &Calibration::mHorizOffsCorr,
+  &Calibration::mDistCorrMeters,
+  &Calibration::mVertOffsCorrMeters,
+  &Calibration::mHorizOffsCorrMeters,
+  &Calibration::mMinIntensity,
+  &Calibration::mMaxIntensity,
+  &Calibration::mFocalDist,
+  &Calibration::mFocalOffset,
+  &Calibration::mFocalSlope,
+  &Calibration::mDistCorrX,
+  &Calibration::mDistCorrY,
+  &Calibration::mDistCorrXSlope,
+  &Calibration::mDistCorrXOffs,
+  &Calibration::mDistCorrYSlope,
+  &Calibration::mDistCorrYOffs
+};
+
+namespace {
+
+/// Binary format header
+struct BinaryHeader {
+  /// Magic number
+  char mMagic[8];
+  /// Version
+  uint32_t mVersion;
+  /// Number of lasers
+  uint32_t mNumLasers;
+  /// Number of lasers in the padded tables
+  uint32_t mNumPaddedLasers;
+  /// Number of tables
+  uint32_t mNumTables;
+  /// Padding to the header size
+  char mReserved[40];
+};
+
+/// Returns the content of the next element with a tag, or false
+bool getElement(const std::string& xml, const std::string& tag, size_t&
+    pos, size_t end, std::string& content) {
+  const std::string openTag = "<" + tag + ">";
+  const std::string closeTag = "</" + tag + ">";
+  const size_t start = xml.find(openTag, pos);
+  if ((start == std::string::npos) || (start >= end))
+    return false;
+  const size_t stop = xml.find(closeTag, start);
+  if ((stop == std::string::npos) || (stop >= end))
+    return false;
+  content = xml.substr(start + openTag.size(), stop - start -
+    openTag.size());
+  pos = stop + closeTag.size();
+  return true;
+}
+
+/// Returns the value of the next element with a tag if present
+bool getValue(const std::string& xml, const std::string& tag, size_t& pos,
+    size_t end, float& value) {
+  size_t elementPos = pos;
+  std::string content;
+  if (!getElement(xml, tag, elementPos, end, content))
+    return false;
+  char* last;
+  value = strtof(content.c_str(), &last);
+  if (last == content.c_str())
+    throw IOException("Calibration::readXML(): bad value for " + tag);
+  pos = elementPos;
+  return true;
+}
+
+/// Returns the items of an array element if present
+bool getItems(const std::string& xml, const std::string& tag,
+    std::vector<float>& items) {
+  size_t pos = xml.find("<" + tag + ">");
+  if (pos == std::string::npos)
+    return false;
+  const size_t end = xml.find("</" + tag + ">", pos);
+  if (end == std::string::npos)
+    throw IOException("Calibration::readXML(): missing end of " + tag);
+  items.clear();
+  float value;
+  while (getValue(xml, "item", pos, end, value))
+    items.push_back(value);
+  return true;
+}
+
+/// Returns the value of the first element with a tag after a position
+float getValue(const std::string& xml, const std::string& tag, size_t pos,
+    size_t end) {
+  float value;
+  if (!getValue(xml, tag, pos, end, value))
+    throw IOException("Calibration::readXML(): missing " + tag);
+  return value;
+}
+
+}
 
 /******************************************************************************/
 /* Constructors and Destructor                                                */
 /******************************************************************************/
 
-Calibration::Calibration(size_t numLasers) :
-    mNumLasers(numLasers) {
-  mCorr = new LaserCorrection[numLasers];
+Calibration::Calibration(size_t numLasers) {
+  resize(numLasers);
 }
 
 Calibration::Calibration(const Calibration& other) :
     Serializable(),
-    mNumLasers(other.mNumLasers) {
-  mCorr = new LaserCorrection[mNumLasers];
-  for (size_t i = 0; i < mNumLasers; ++i)
-    mCorr[i] = other.mCorr[i];
+    mNumLasers(other.mNumLasers),
+    mRotCorr(other.mRotCorr),
+    mSinRotCorr(other.mSinRotCorr),
+    mCosRotCorr(other.mCosRotCorr),
+    mVertCorr(other.mVertCorr),
+    mSinVertCorr(other.mSinVertCorr),
+    mCosVertCorr(other.mCosVertCorr),
+    mDistCorr(other.mDistCorr),
+    mVertOffsCorr(other.mVertOffsCorr),
+    mHorizOffsCorr(other.mHorizOffsCorr),
+    mDistCorrMeters(other.mDistCorrMeters),
+    mVertOffsCorrMeters(other.mVertOffsCorrMeters),
+    mHorizOffsCorrMeters(other.mHorizOffsCorrMeters),
+    mMinIntensity(other.mMinIntensity),
+    mMaxIntensity(other.mMaxIntensity),
+    mFocalDist(other.mFocalDist),
+    mFocalOffset(other.mFocalOffset),
+    mFocalSlope(other.mFocalSlope),
+    mDistCorrX(other.mDistCorrX),
+    mDistCorrY(other.mDistCorrY),
+    mDistCorrXSlope(other.mDistCorrXSlope),
+    mDistCorrXOffs(other.mDistCorrXOffs),
+    mDistCorrYSlope(other.mDistCorrYSlope),
+    mDistCorrYOffs(other.mDistCorrYOffs) {
 }
 
 Calibration& Calibration::operator = (const Calibration& other) {
   if (this != &other) {
     mNumLasers = other.mNumLasers;
-    mCorr = new LaserCorrection[mNumLasers];
-    for (size_t i = 0; i < mNumLasers; ++i)
-      mCorr[i] = other.mCorr[i];
+    mRotCorr = other.mRotCorr;
+    mSinRotCorr = other.mSinRotCorr;
+    mCosRotCorr = other.mCosRotCorr;
+    mVertCorr = other.mVertCorr;
+    mSinVertCorr = other.mSinVertCorr;
+    mCosVertCorr = other.mCosVertCorr;
+    mDistCorr = other.mDistCorr;
+    mVertOffsCorr = other.mVertOffsCorr;
+    mHorizOffsCorr = other.mHorizOffsCorr;
+    mDistCorrMeters = other.mDistCorrMeters;
+    mVertOffsCorrMeters = other.mVertOffsCorrMeters;
+    mHorizOffsCorrMeters = other.mHorizOffsCorrMeters;
+    mMinIntensity = other.mMinIntensity;
+    mMaxIntensity = other.mMaxIntensity;
+    mFocalDist = other.mFocalDist;
+    mFocalOffset = other.mFocalOffset;
+    mFocalSlope = other.mFocalSlope;
+    mDistCorrX = other.mDistCorrX;
+    mDistCorrY = other.mDistCorrY;
+    mDistCorrXSlope = other.mDistCorrXSlope;
+    mDistCorrXOffs = other.mDistCorrXOffs;
+    mDistCorrYSlope = other.mDistCorrYSlope;
+    mDistCorrYOffs = other.mDistCorrYOffs;
   }
   return *this;
 }
 
 Calibration::~Calibration() {
-  if (mCorr)
-    delete [] mCorr;
 }
 
 /******************************************************************************/
@@ -64,11 +237,11 @@ void Calibration::read(std::istream& /*stream*/) {
 void Calibration::write(std::ostream& stream) const {
   for (size_t i = 0; i < mNumLasers; ++i) {
     stream << "id " << i << std::endl
-           << "rotCorrection " << rad2deg(mCorr[i].mRotCorr) << std::endl
-           << "vertCorrection " << rad2deg(mCorr[i].mVertCorr) << std::endl
-           << "distCorrection " << mCorr[i].mDistCorr << std::endl
-           << "vertOffsetCorrection " << mCorr[i].mVertOffsCorr << std::endl
-           << "horizOffsetCorrection " << mCorr[i].mHorizOffsCorr << std::endl
+           << "rotCorrection " << rad2deg(mRotCorr[i]) << std::endl
+           << "vertCorrection " << rad2deg(mVertCorr[i]) << std::endl
+           << "distCorrection " << mDistCorr[i] << std::endl
+           << "vertOffsetCorrection " << mVertOffsCorr[i] << std::endl
+           << "horizOffsetCorrection " << mHorizOffsCorr[i] << std::endl
            << std::endl;
   }
 }
@@ -84,36 +257,32 @@ void Calibration::read(std::ifstream& stream) {
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
     if ((size_t)value != i)
-      throw IOException("Calibration::read(): Unexcepted id");
+      throw IOException("Calibration::read(): unexpected id");
     stream >> strKey;
     if (strKey.compare("rotCorrection") != 0)
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
-    mCorr[i].mRotCorr = deg2rad(value);
-    mCorr[i].mSinRotCorr = sin(mCorr[i].mRotCorr);
-    mCorr[i].mCosRotCorr = cos(mCorr[i].mRotCorr);
+    setRotCorr(i, value);
     stream >> strKey;
     if (strKey.compare("vertCorrection") != 0)
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
-    mCorr[i].mVertCorr = deg2rad(value);
-    mCorr[i].mSinVertCorr = sin(mCorr[i].mVertCorr);
-    mCorr[i].mCosVertCorr = cos(mCorr[i].mVertCorr);
+    setVertCorr(i, value);
     stream >> strKey;
     if (strKey.compare("distCorrection") != 0)
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
-    mCorr[i].mDistCorr = value;
+    setDistCorr(i, value);
     stream >> strKey;
     if (strKey.compare("vertOffsetCorrection") != 0)
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
-    mCorr[i].mVertOffsCorr = value;
+    setVertOffsCorr(i, value);
     stream >> strKey;
     if (strKey.compare("horizOffsetCorrection") != 0)
       throw IOException("Calibration::read(): Unexcepted key");
     stream >> value;
-    mCorr[i].mHorizOffsCorr = value;
+    setHorizOffsCorr(i, value);
   }
 }
 
@@ -122,11 +291,11 @@ void Calibration::write(std::ofstream& stream) const {
     throw IOException("Calibration::write(): could not open file");
   for (size_t i = 0; i < mNumLasers; ++i) {
     stream << "id " << i << std::endl
-           << "rotCorrection " << rad2deg(mCorr[i].mRotCorr) << std::endl
-           << "vertCorrection " << rad2deg(mCorr[i].mVertCorr) << std::endl
-           << "distCorrection " << mCorr[i].mDistCorr << std::endl
-           << "vertOffsetCorrection " << mCorr[i].mVertOffsCorr << std::endl
-           << "horizOffsetCorrection " << mCorr[i].mHorizOffsCorr << std::endl
+           << "rotCorrection " << rad2deg(mRotCorr[i]) << std::endl
+           << "vertCorrection " << rad2deg(mVertCorr[i]) << std::endl
+           << "distCorrection " << mDistCorr[i] << std::endl
+           << "vertOffsetCorrection " << mVertOffsCorr[i] << std::endl
+           << "horizOffsetCorrection " << mHorizOffsCorr[i] << std::endl
            << std::endl;
   }
 }
@@ -135,22 +304,309 @@ void Calibration::write(std::ofstream& stream) const {
 /* Accessors                                                                  */
 /******************************************************************************/
 
+Calibration::Tables Calibration::getTables() const {
+  Tables tables;
+  tables.mRotCorr = &mRotCorr[0];
+  tables.mSinRotCorr = &mSinRotCorr[0];
+  tables.mCosRotCorr = &mCosRotCorr[0];
+  tables.mVertCorr = &mVertCorr[0];
+  tables.mSinVertCorr = &mSinVertCorr[0];
+  tables.mCosVertCorr = &mCosVertCorr[0];
+  tables.mDistCorr = &mDistCorrMeters[0];
+  tables.mVertOffsCorr = &mVertOffsCorrMeters[0];
+  tables.mHorizOffsCorr = &mHorizOffsCorrMeters[0];
+  tables.mMinIntensity = &mMinIntensity[0];
+  tables.mMaxIntensity = &mMaxIntensity[0];
+  tables.mFocalOffset = &mFocalOffset[0];
+  tables.mFocalSlope = &mFocalSlope[0];
+  tables.mDistCorrXSlope = &mDistCorrXSlope[0];
+  tables.mDistCorrXOffs = &mDistCorrXOffs[0];
+  tables.mDistCorrYSlope = &mDistCorrYSlope[0];
+  tables.mDistCorrYOffs = &mDistCorrYOffs[0];
+  return tables;
+}
+
 void Calibration::setRotCorr(size_t laserNbr, float value) {
-  if (laserNbr > mNumLasers)
+  if (laserNbr >= mNumLasers)
     throw OutOfBoundException<size_t>(laserNbr,
       "Calibration::setRotCorr(): Out of bound",
       __FILE__, __LINE__);
-  mCorr[laserNbr].mRotCorr = deg2rad(value);
-  mCorr[laserNbr].mSinRotCorr = sin(mCorr[laserNbr].mRotCorr);
-  mCorr[laserNbr].mCosRotCorr = cos(mCorr[laserNbr].mRotCorr);
+  mRotCorr[laserNbr] = deg2rad(value);
+  mSinRotCorr[laserNbr] = sin(mRotCorr[laserNbr]);
+  mCosRotCorr[laserNbr] = cos(mRotCorr[laserNbr]);
 }
 
 void Calibration::setVertCorr(size_t laserNbr, float value) {
-  if (laserNbr > mNumLasers)
+  if (laserNbr >= mNumLasers)
     throw OutOfBoundException<size_t>(laserNbr,
       "Calibration::setVertCorr(): Out of bound",
       __FILE__, __LINE__);
-  mCorr[laserNbr].mVertCorr = deg2rad(value);
-  mCorr[laserNbr].mSinVertCorr = sin(mCorr[laserNbr].mVertCorr);
-  mCorr[laserNbr].mCosVertCorr = cos(mCorr[laserNbr].mVertCorr);
+  mVertCorr[laserNbr] = deg2rad(value);
+  mSinVertCorr[laserNbr] = sin(mVertCorr[laserNbr]);
+  mCosVertCorr[laserNbr] = cos(mVertCorr[laserNbr]);
+}
+
+void Calibration::setDistCorr(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setDistCorr(): Out of bound",
+      __FILE__, __LINE__);
+  mDistCorr[laserNbr] = value;
+  mDistCorrMeters[laserNbr] = value / static_cast<float>(mMeterConversion);
+  mDistCorrX[laserNbr] = value;
+  mDistCorrY[laserNbr] = value;
+  updateTwoPointCorr(laserNbr);
+}
+
+void Calibration::setDistCorrX(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setDistCorrX(): Out of bound",
+      __FILE__, __LINE__);
+  mDistCorrX[laserNbr] = value;
+  updateTwoPointCorr(laserNbr);
+}
+
+void Calibration::setDistCorrY(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setDistCorrY(): Out of bound",
+      __FILE__, __LINE__);
+  mDistCorrY[laserNbr] = value;
+  updateTwoPointCorr(laserNbr);
+}
+
+void Calibration::setVertOffsCorr(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setVertOffsCorr(): Out of bound",
+      __FILE__, __LINE__);
+  mVertOffsCorr[laserNbr] = value;
+  mVertOffsCorrMeters[laserNbr] = value /
+    static_cast<float>(mMeterConversion);
+}
+
+void Calibration::setHorizOffsCorr(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setHorizOffsCorr(): Out of bound",
+      __FILE__, __LINE__);
+  mHorizOffsCorr[laserNbr] = value;
+  mHorizOffsCorrMeters[laserNbr] = value /
+    static_cast<float>(mMeterConversion);
+}
+
+void Calibration::setMinIntensity(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setMinIntensity(): Out of bound",
+      __FILE__, __LINE__);
+  if ((value < 0) || (value > mIntensityMax))
+    throw BadArgumentException<float>(value,
+      "Calibration::setMinIntensity(): intensity out of range",
+      __FILE__, __LINE__);
+  mMinIntensity[laserNbr] = value;
+}
+
+void Calibration::setMaxIntensity(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setMaxIntensity(): Out of bound",
+      __FILE__, __LINE__);
+  if ((value < 0) || (value > mIntensityMax))
+    throw BadArgumentException<float>(value,
+      "Calibration::setMaxIntensity(): intensity out of range",
+      __FILE__, __LINE__);
+  mMaxIntensity[laserNbr] = value;
+}
+
+void Calibration::setFocalDist(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setFocalDist(): Out of bound",
+      __FILE__, __LINE__);
+  mFocalDist[laserNbr] = value;
+  const float scale = 1.0f - value / mFocalDistanceNorm;
+  mFocalOffset[laserNbr] = mFocalOffsetScale * scale * scale;
+}
+
+void Calibration::setFocalSlope(size_t laserNbr, float value) {
+  if (laserNbr >= mNumLasers)
+    throw OutOfBoundException<size_t>(laserNbr,
+      "Calibration::setFocalSlope(): Out of bound",
+      __FILE__, __LINE__);
+  mFocalSlope[laserNbr] = value;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void Calibration::resize(size_t numLasers) {
+  mNumLasers = numLasers;
+  const size_t numPaddedLasers = getNumPaddedLasers(numLasers);
+  for (size_t i = 0; i < mNumTables; ++i)
+    (this->*mTableMembers[i]).assign(numPaddedLasers, 0);
+  mMaxIntensity.assign(numPaddedLasers, mIntensityMax);
+  mFocalOffset.assign(numPaddedLasers, mFocalOffsetScale);
+}
+
+void Calibration::updateTwoPointCorr(size_t laserNbr) {
+  const float distCorr = mDistCorrMeters[laserNbr];
+  const float distCorrX = mDistCorrX[laserNbr] /
+    static_cast<float>(mMeterConversion);
+  const float distCorrY = mDistCorrY[laserNbr] /
+    static_cast<float>(mMeterConversion);
+  mDistCorrXSlope[laserNbr] = (distCorr - distCorrX) /
+    (mDistCorrFar - mDistCorrXNear);
+  mDistCorrXOffs[laserNbr] = distCorrX - distCorr -
+    mDistCorrXSlope[laserNbr] * mDistCorrXNear;
+  mDistCorrYSlope[laserNbr] = (distCorr - distCorrY) /
+    (mDistCorrFar - mDistCorrYNear);
+  mDistCorrYOffs[laserNbr] = distCorrY - distCorr -
+    mDistCorrYSlope[laserNbr] * mDistCorrYNear;
+}
+
+void Calibration::readXML(std::istream& stream) {
+  const std::string xml((std::istreambuf_iterator<char>(stream)),
+    std::istreambuf_iterator<char>());
+  size_t pos = xml.find("<points_");
+  const size_t end = xml.find("</points_>");
+  if ((pos == std::string::npos) || (end == std::string::npos))
+    throw IOException("Calibration::readXML(): missing points_");
+  std::string content;
+  if (!getElement(xml, "count", pos, end, content))
+    throw IOException("Calibration::readXML(): missing count");
+  const size_t numLasers = strtoul(content.c_str(), 0, 10);
+  resize(numLasers);
+  for (size_t i = 0; i < numLasers; ++i) {
+    pos = xml.find("<px", pos);
+    const size_t pxEnd = xml.find("</px>", pos);
+    if ((pos == std::string::npos) || (pxEnd == std::string::npos) ||
+        (pxEnd > end))
+      throw IOException("Calibration::readXML(): missing px");
+    const size_t id = getValue(xml, "id_", pos, pxEnd);
+    if (id >= numLasers)
+      throw IOException("Calibration::readXML(): unexpected id");
+    setRotCorr(id, getValue(xml, "rotCorrection_", pos, pxEnd));
+    setVertCorr(id, getValue(xml, "vertCorrection_", pos, pxEnd));
+    setDistCorr(id, getValue(xml, "distCorrection_", pos, pxEnd));
+    setVertOffsCorr(id, getValue(xml, "vertOffsetCorrection_", pos, pxEnd));
+    setHorizOffsCorr(id, getValue(xml, "horizOffsetCorrection_", pos,
+      pxEnd));
+    float value;
+    size_t elementPos = pos;
+    if (getValue(xml, "distCorrectionX_", elementPos, pxEnd, value))
+      setDistCorrX(id, value);
+    elementPos = pos;
+    if (getValue(xml, "distCorrectionY_", elementPos, pxEnd, value))
+      setDistCorrY(id, value);
+    elementPos = pos;
+    if (getValue(xml, "focalDistance_", elementPos, pxEnd, value))
+      setFocalDist(id, value);
+    elementPos = pos;
+    if (getValue(xml, "focalSlope_", elementPos, pxEnd, value))
+      setFocalSlope(id, value);
+    pos = pxEnd;
+  }
+  std::vector<float> items;
+  if (getItems(xml, "minIntensity_", items))
+    for (size_t i = 0; i < std::min(items.size(), numLasers); ++i)
+      setMinIntensity(i, items[i]);
+  if (getItems(xml, "maxIntensity_", items))
+    for (size_t i = 0; i < std::min(items.size(), numLasers); ++i)
+      setMaxIntensity(i, items[i]);
+}
+
+void Calibration::writeBinary(std::ostream& stream) const {
+  BinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.mMagic, mBinaryMagic, sizeof(header.mMagic));
+  header.mVersion = mBinaryVersion;
+  header.mNumLasers = mNumLasers;
+  header.mNumPaddedLasers = getNumPaddedLasers();
+  header.mNumTables = mNumTables;
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (size_t i = 0; i < mNumTables; ++i)
+    stream.write(reinterpret_cast<const char*>(&(this->*mTableMembers[i])[0]),
+      getNumPaddedLasers() * sizeof(float));
+}
+
+void Calibration::readBinary(std::istream& stream) {
+  const std::string buffer((std::istreambuf_iterator<char>(stream)),
+    std::istreambuf_iterator<char>());
+  readBinary(buffer.data(), buffer.size());
+}
+
+void Calibration::readBinary(const char* buffer, size_t size) {
+  BinaryHeader header;
+  if (size < sizeof(header))
+    throw IOException("Calibration::readBinary(): truncated header");
+  memcpy(&header, buffer, sizeof(header));
+  if (memcmp(header.mMagic, mBinaryMagic, sizeof(header.mMagic)))
+    throw IOException("Calibration::readBinary(): bad magic number");
+  if (header.mVersion != mBinaryVersion)
+    throw IOException("Calibration::readBinary(): unsupported version");
+  const size_t numPaddedLasers = getNumPaddedLasers(header.mNumLasers);
+  if ((header.mNumPaddedLasers != numPaddedLasers) ||
+      (header.mNumTables != mNumTables))
+    throw IOException("Calibration::readBinary(): bad table layout");
+  const size_t tableSize = numPaddedLasers * sizeof(float);
+  if ((size - sizeof(header)) / mNumTables < tableSize)
+    throw IOException("Calibration::readBinary(): truncated tables");
+  resize(header.mNumLasers);
+  for (size_t i = 0; i < mNumTables; ++i)
+    memcpy(&(this->*mTableMembers[i])[0], buffer + sizeof(header) + i *
+      tableSize, tableSize);
+}
+
+void Calibration::mapBinary(const std::string& filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw SystemException(errno, "Calibration::mapBinary()::open()");
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1) {
+    const int error = errno;
+    close(fd);
+    throw SystemException(error, "Calibration::mapBinary()::fstat()");
+  }
+  const size_t size = fileStat.st_size;
+  void* buffer = size ? mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0) :
+    MAP_FAILED;
+  const int error = errno;
+  close(fd);
+  if (buffer == MAP_FAILED)
+    throw SystemException(size ? error : EINVAL,
+      "Calibration::mapBinary()::mmap()");
+  try {
+    readBinary(static_cast<const char*>(buffer), size);
+  }
+  catch (...) {
+    munmap(buffer, size);
+    throw;
+  }
+  munmap(buffer, size);
+}
+
+void Calibration::load(const std::string& filename) {
+  std::ifstream file(filename.c_str());
+  if (!file.is_open())
+    throw IOException("Calibration::load(): could not open file");
+  char magic[sizeof(mBinaryMagic)];
+  file.read(magic, sizeof(magic));
+  if ((file.gcount() == sizeof(magic)) &&
+      !memcmp(magic, mBinaryMagic, sizeof(magic))) {
+    file.close();
+    mapBinary(filename);
+    return;
+  }
+  file.clear();
+  file.seekg(0);
+  file >> std::ws;
+  if (file.peek() == '<')
+    readXML(file);
+  else {
+    resize(mNumLasers);
+    file >> *this;
+  }
 }
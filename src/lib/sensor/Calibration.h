@@ -25,13 +25,36 @@
 #define CALIBRATION_H
 
 #include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
 
 #include "base/Serializable.h"
+#include "data-structures/AlignedAllocator.h"
 
 #include "exceptions/OutOfBoundException.h"
 
 /** The class Calibration represents the calibration structure for the
-    Velodyne.
+    Velodyne. The corrections are stored in structure-of-arrays layout, one
+    64-byte aligned table per correction padded to a multiple of 16 lasers,
+    which getTables() exports to the vectorized conversion kernels. The
+    distortion and offset corrections are also kept premultiplied in meters.
+    The intensity corrections of the S2 sensors clamp the intensity of a laser
+    to its range and add a term depending on the focal distance and slope,
+    whose offset is precomputed per laser. They are neutral by default.
+    The two-point distance corrections of the S2 sensors interpolate the
+    distortion correction between a near and a far value along x and y. They
+    are stored as linear coefficients in the absolute projections of the
+    planar distance, before the horizontal offset, so that the kernels apply
+    them without branching. Setting the distortion correction resets the
+    two-point corrections of the laser to it.
+    Besides the text format of the stream operators, it reads the Velodyne
+    db.xml format and a binary cache format. The binary format is a 64-byte
+    header followed by the tables in native byte order, with the layout of
+    memory so that it is memory-mapped and copied without any parsing.
     \brief Velodyne calibration
   */
 class Calibration :
@@ -40,65 +63,44 @@ public:
   /** \name Types definitions
     @{
     */
-  /// The LaserCorrection struct defines the laser correction.
-  struct LaserCorrection {
-    /// Rotation correction
-    float mRotCorr;
-    /// Sinus of rotation correction
-    float mSinRotCorr;
-    /// Cosinus of rotation correction
-    float mCosRotCorr;
-    /// Vertical correction
-    float mVertCorr;
-    /// Sinus of vertical correction
-    float mSinVertCorr;
-    /// Cosinus of vertical correction
-    float mCosVertCorr;
-    /// Distortion correction
-    float mDistCorr;
-    /// Vertical offset correction
-    float mVertOffsCorr;
-    /// Horizontal offset correction
-    float mHorizOffsCorr;
-    /// Default constructor
-    LaserCorrection() :
-        mRotCorr(0),
-        mSinRotCorr(0),
-        mCosRotCorr(0),
-        mVertCorr(0),
-        mSinVertCorr(0),
-        mCosVertCorr(0),
-        mDistCorr(0),
-        mVertOffsCorr(0),
-        mHorizOffsCorr(0) {
-    }
-    /// Copy constructor
-    LaserCorrection(const LaserCorrection& other) :
-        mRotCorr(other.mRotCorr),
-        mSinRotCorr(other.mSinRotCorr),
-        mCosRotCorr(other.mCosRotCorr),
-        mVertCorr(other.mVertCorr),
-        mSinVertCorr(other.mSinVertCorr),
-        mCosVertCorr(other.mCosVertCorr),
-        mDistCorr(other.mDistCorr),
-        mVertOffsCorr(other.mVertOffsCorr),
-        mHorizOffsCorr(other.mHorizOffsCorr) {
-    }
-    // Assignment operator
-    LaserCorrection& operator = (const LaserCorrection& other) {
-      if (this != &other) {
-        mRotCorr = other.mRotCorr;
-        mSinRotCorr = other.mSinRotCorr;
-        mCosRotCorr =other.mCosRotCorr;
-        mVertCorr = other.mVertCorr;
-        mSinVertCorr = other.mSinVertCorr;
-        mCosVertCorr = other.mCosVertCorr;
-        mDistCorr =other.mDistCorr;
-        mVertOffsCorr = other.mVertOffsCorr;
-        mHorizOffsCorr = other.mHorizOffsCorr;
-      }
-      return *this;
-    }
+  /// Correction table type
+  typedef std::vector<float, AlignedAllocator<float> > Table;
+  /// The struct Tables is a read-only view of the correction tables.
+  struct Tables {
+    /// Rotation corrections
+    const float* mRotCorr;
+    /// Sinus of rotation corrections
+    const float* mSinRotCorr;
+    /// Cosinus of rotation corrections
+    const float* mCosRotCorr;
+    /// Vertical corrections
+    const float* mVertCorr;
+    /// Sinus of vertical corrections
+    const float* mSinVertCorr;
+    /// Cosinus of vertical corrections
+    const float* mCosVertCorr;
+    /// Distortion corrections in meters
+    const float* mDistCorr;
+    /// Vertical offset corrections in meters
+    const float* mVertOffsCorr;
+    /// Horizontal offset corrections in meters
+    const float* mHorizOffsCorr;
+    /// Minimum intensities
+    const float* mMinIntensity;
+    /// Maximum intensities
+    const float* mMaxIntensity;
+    /// Focal offsets of the intensity correction
+    const float* mFocalOffset;
+    /// Focal slopes of the intensity correction
+    const float* mFocalSlope;
+    /// Slopes of the two-point distance correction along x
+    const float* mDistCorrXSlope;
+    /// Offsets of the two-point distance correction along x in meters
+    const float* mDistCorrXOffs;
+    /// Slopes of the two-point distance correction along y
+    const float* mDistCorrYSlope;
+    /// Offsets of the two-point distance correction along y in meters
+    const float* mDistCorrYOffs;
   };
   /** @}
     */
@@ -124,136 +126,218 @@ public:
   size_t getNumLasers() const {
     return mNumLasers;
   }
+  /// Returns the number of lasers in the padded tables
+  size_t getNumPaddedLasers() const {
+    return mRotCorr.size();
+  }
+  /// Returns the view of the correction tables
+  Tables getTables() const;
   /// Returns the rotation correction
   float getRotCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getRotCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mRotCorr;
+    return mRotCorr[laserNbr];
   }
   /// Sets the rotation correction
   void setRotCorr(size_t laserNbr, float value);
   /// Returns the sinus of rotation correction
   float getSinRotCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getSinRotCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mSinRotCorr;
+    return mSinRotCorr[laserNbr];
   }
   /// Returns the cosinus of rotation correction
   float getCosRotCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getCosRotCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mCosRotCorr;
+    return mCosRotCorr[laserNbr];
   }
   /// Returns the vertical correction
   float getVertCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getVertCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mVertCorr;
+    return mVertCorr[laserNbr];
   }
   /// Sets the vertical correction
   void setVertCorr(size_t laserNbr, float value);
   /// Returns the sinus of vertical correction
   float getSinVertCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getSinVertCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mSinVertCorr;
+    return mSinVertCorr[laserNbr];
   }
   /// Returns the cosinus of vertical correction
   float getCosVertCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getCosVertCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mCosVertCorr;
+    return mCosVertCorr[laserNbr];
   }
   /// Returns the distortion correction
   float getDistCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getDistCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mDistCorr;
+    return mDistCorr[laserNbr];
   }
   /// Sets the distortion correction
-  void setDistCorr(size_t laserNbr, float value) {
+  void setDistCorr(size_t laserNbr, float value);
+  /// Returns the near distortion correction along x
+  float getDistCorrX(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
-        "Calibration::setDistCorr(): Out of bound",
+        "Calibration::getDistCorrX(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    mCorr[laserNbr].mDistCorr = value;
+    return mDistCorrX[laserNbr];
   }
-  /// Returns the vertical offset correction
-  float getVertOffsCorr(size_t laserNbr) const {
+  /// Sets the near distortion correction along x
+  void setDistCorrX(size_t laserNbr, float value);
+  /// Returns the near distortion correction along y
+  float getDistCorrY(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
-        "Calibration::getVertOffsCorr(): Out of bound",
+        "Calibration::getDistCorrY(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mVertOffsCorr;
+    return mDistCorrY[laserNbr];
   }
-  /// Sets the vertical offset correction
-  void setVertOffsCorr(size_t laserNbr, float value) {
+  /// Sets the near distortion correction along y
+  void setDistCorrY(size_t laserNbr, float value);
+  /// Returns the vertical offset correction
+  float getVertOffsCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
-        "Calibration::setVertOffsCorr(): Out of bound",
+        "Calibration::getVertOffsCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    mCorr[laserNbr].mVertOffsCorr = value;
+    return mVertOffsCorr[laserNbr];
   }
+  /// Sets the vertical offset correction
+  void setVertOffsCorr(size_t laserNbr, float value);
   /// Returns the horizontal offset correction
   float getHorizOffsCorr(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
         "Calibration::getHorizOffsCorr(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    return mCorr[laserNbr].mHorizOffsCorr;
+    return mHorizOffsCorr[laserNbr];
   }
   /// Sets the horizontal offset correction
-  void setHorizOffsCorr(size_t laserNbr, float value) {
+  void setHorizOffsCorr(size_t laserNbr, float value);
+  /// Returns the minimum intensity
+  float getMinIntensity(size_t laserNbr) const {
+#ifndef NDEBUG
+    if (laserNbr >= mNumLasers)
+      throw OutOfBoundException<size_t>(laserNbr,
+        "Calibration::getMinIntensity(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mMinIntensity[laserNbr];
+  }
+  /// Sets the minimum intensity
+  void setMinIntensity(size_t laserNbr, float value);
+  /// Returns the maximum intensity
+  float getMaxIntensity(size_t laserNbr) const {
+#ifndef NDEBUG
+    if (laserNbr >= mNumLasers)
+      throw OutOfBoundException<size_t>(laserNbr,
+        "Calibration::getMaxIntensity(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mMaxIntensity[laserNbr];
+  }
+  /// Sets the maximum intensity
+  void setMaxIntensity(size_t laserNbr, float value);
+  /// Returns the focal distance of the intensity correction
+  float getFocalDist(size_t laserNbr) const {
 #ifndef NDEBUG
-    if (laserNbr > mNumLasers)
+    if (laserNbr >= mNumLasers)
       throw OutOfBoundException<size_t>(laserNbr,
-        "Calibration::setHorizOffsCorr(): Out of bound",
+        "Calibration::getFocalDist(): Out of bound",
         __FILE__, __LINE__);
 #endif
-    mCorr[laserNbr].mHorizOffsCorr = value;
+    return mFocalDist[laserNbr];
   }
+  /// Sets the focal distance of the intensity correction
+  void setFocalDist(size_t laserNbr, float value);
+  /// Returns the focal offset of the intensity correction
+  float getFocalOffset(size_t laserNbr) const {
+#ifndef NDEBUG
+    if (laserNbr >= mNumLasers)
+      throw OutOfBoundException<size_t>(laserNbr,
+        "Calibration::getFocalOffset(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mFocalOffset[laserNbr];
+  }
+  /// Returns the focal slope of the intensity correction
+  float getFocalSlope(size_t laserNbr) const {
+#ifndef NDEBUG
+    if (laserNbr >= mNumLasers)
+      throw OutOfBoundException<size_t>(laserNbr,
+        "Calibration::getFocalSlope(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mFocalSlope[laserNbr];
+  }
+  /// Sets the focal slope of the intensity correction
+  void setFocalSlope(size_t laserNbr, float value);
   /** @}
     */
 
   /** \name Methods
     @{
     */
+  /// Reads the Velodyne db.xml format
+  void readXML(std::istream& stream);
+  /// Writes the binary format into an output stream
+  void writeBinary(std::ostream& stream) const;
+  /// Reads the binary format from an input stream
+  void readBinary(std::istream& stream);
+  /// Reads the binary format from a file through a memory mapping
+  void mapBinary(const std::string& filename);
+  /// Reads a file in binary, db.xml or text format
+  void load(const std::string& filename);
+  /// Returns the corrected intensity of a raw return
+  static float correctIntensity(float intensity, float rawDistance, float
+      focalOffset, float focalSlope, float minIntensity, float maxIntensity) {
+    const float scale = 1.0f - rawDistance / mFocalDistanceScale;
+    intensity += focalSlope * std::fabs(focalOffset - mFocalOffsetScale *
+      scale * scale);
+    return std::min(std::max(intensity, minIntensity), maxIntensity);
+  }
   /// Converts degree to radian
   static float deg2rad(float deg) {
     return deg * M_PI / 180.0;
@@ -265,6 +349,36 @@ public:
   /** @}
     */
 
+  /** \name Public members
+    @{
+    */
+  /// Number of lasers the tables are padded to a multiple of
+  static const size_t mTablePadding = 16;
+  /// Number of centimeters in a meter
+  static const size_t mMeterConversion = 100;
+  /// Maximum intensity of a return
+  static const size_t mIntensityMax = 255;
+  /// Raw distance normalizing the intensity correction
+  static const float mFocalDistanceScale;
+  /// Normalizer of the focal distances
+  static const float mFocalDistanceNorm;
+  /// Scale of the focal offsets
+  static const float mFocalOffsetScale;
+  /// Distance along x in meters of the near distortion correction
+  static const float mDistCorrXNear;
+  /// Distance along y in meters of the near distortion correction
+  static const float mDistCorrYNear;
+  /// Distance in meters of the far distortion correction
+  static const float mDistCorrFar;
+  /// Magic number of the binary format
+  static const char mBinaryMagic[8];
+  /// Version of the binary format
+  static const uint32_t mBinaryVersion = 3;
+  /// Size of the header of the binary format
+  static const size_t mBinaryHeaderSize = 64;
+  /** @}
+    */
+
 protected:
   /** \name Stream methods
     @{
@@ -280,13 +394,83 @@ protected:
   /** @}
     */
 
+  /** \name Protected methods
+    @{
+    */
+  /// Returns the number of lasers in the padded tables for a number of lasers
+  static size_t getNumPaddedLasers(size_t numLasers) {
+    return (numLasers + mTablePadding - 1) / mTablePadding * mTablePadding;
+  }
+  /// Resizes the tables for a number of lasers and zeroes them
+  void resize(size_t numLasers);
+  /// Reads the tables from a buffer in binary format
+  void readBinary(const char* buffer, size_t size);
+  /// Updates the coefficients of the two-point distance correction
+  void updateTwoPointCorr(size_t laserNbr);
+  /** @}
+    */
+
   /** \name Protected members
     @{
     */
   /// Number of lasers in the Velodyne
   size_t mNumLasers;
-  /// Laser corrections
-  LaserCorrection* mCorr;
+  /// Rotation corrections
+  Table mRotCorr;
+  /// Sinus of rotation corrections
+  Table mSinRotCorr;
+  /// Cosinus of rotation corrections
+  Table mCosRotCorr;
+  /// Vertical corrections
+  Table mVertCorr;
+  /// Sinus of vertical corrections
+  Table mSinVertCorr;
+  /// Cosinus of vertical corrections
+  Table mCosVertCorr;
+  /// Distortion corrections
+  Table mDistCorr;
+  /// Vertical offset corrections
+  Table mVertOffsCorr;
+  /// Horizontal offset corrections
+  Table mHorizOffsCorr;
+  /// Distortion corrections in meters
+  Table mDistCorrMeters;
+  /// Vertical offset corrections in meters
+  Table mVertOffsCorrMeters;
+  /// Horizontal offset corrections in meters
+  Table mHorizOffsCorrMeters;
+  /// Minimum intensities
+  Table mMinIntensity;
+  /// Maximum intensities
+  Table mMaxIntensity;
+  /// Focal distances of the intensity correction
+  Table mFocalDist;
+  /// Focal offsets of the intensity correction
+  Table mFocalOffset;
+  /// Focal slopes of the intensity correction
+  Table mFocalSlope;
+  /// Near distortion corrections along x
+  Table mDistCorrX;
+  /// Near distortion corrections along y
+  Table mDistCorrY;
+  /// Slopes of the two-point distance correction along x
+  Table mDistCorrXSlope;
+  /// Offsets of the two-point distance correction along x in meters
+  Table mDistCorrXOffs;
+  /// Slopes of the two-point distance correction along y
+  Table mDistCorrYSlope;
+  /// Offsets of the two-point distance correction along y in meters
+  Table mDistCorrYOffs;
+  /** @}
+    */
+
+  /** \name Protected static members
+    @{
+    */
+  /// Number of tables
+  static const size_t mNumTables = 23;
+  /// Tables in the order of the binary format
+  static Table Calibration::* const mTableMembers[mNumTables];
   /** @}
     */
 
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/ConstantVelocityModel.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+ConstantVelocityModel::ConstantVelocityModel(double vx, double vy, double vz,
+    double wx, double wy, double wz) {
+  setLinearVelocity(vx, vy, vz);
+  setAngularVelocity(wx, wy, wz);
+}
+
+ConstantVelocityModel::ConstantVelocityModel(const ConstantVelocityModel&
+    other) :
+    MotionModel() {
+  setLinearVelocity(other.mLinearVelocity[0], other.mLinearVelocity[1],
+    other.mLinearVelocity[2]);
+  setAngularVelocity(other.mAngularVelocity[0], other.mAngularVelocity[1],
+    other.mAngularVelocity[2]);
+}
+
+ConstantVelocityModel& ConstantVelocityModel::operator =
+    (const ConstantVelocityModel& other) {
+  if (this != &other) {
+    setLinearVelocity(other.mLinearVelocity[0], other.mLinearVelocity[1],
+      other.mLinearVelocity[2]);
+    setAngularVelocity(other.mAngularVelocity[0], other.mAngularVelocity[1],
+      other.mAngularVelocity[2]);
+  }
+  return *this;
+}
+
+ConstantVelocityModel::~ConstantVelocityModel() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+void ConstantVelocityModel::setLinearVelocity(double vx, double vy, double
+    vz) {
+  mLinearVelocity[0] = vx;
+  mLinearVelocity[1] = vy;
+  mLinearVelocity[2] = vz;
+}
+
+void ConstantVelocityModel::setAngularVelocity(double wx, double wy, double
+    wz) {
+  mAngularVelocity[0] = wx;
+  mAngularVelocity[1] = wy;
+  mAngularVelocity[2] = wz;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+Pose ConstantVelocityModel::getRelativePose(int64_t timestamp, int64_t
+    reference) const {
+  const double dt = (timestamp - reference) * 1e-9;
+  return Pose::fromRotationVector(mLinearVelocity[0] * dt,
+    mLinearVelocity[1] * dt, mLinearVelocity[2] * dt,
+    mAngularVelocity[0] * dt, mAngularVelocity[1] * dt,
+    mAngularVelocity[2] * dt);
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file ConstantVelocityModel.h
+    \brief This file defines the ConstantVelocityModel class, which represents
+           a sensor moving at constant velocity
+  */
+
+#ifndef CONSTANTVELOCITYMODEL_H
+#define CONSTANTVELOCITYMODEL_H
+
+#include "sensor/MotionModel.h"
+
+/** The class ConstantVelocityModel represents a sensor moving at constant
+    linear and angular velocities, both expressed in the sensor frame at the
+    reference time.
+    \brief Constant velocity motion model
+  */
+class ConstantVelocityModel :
+  public MotionModel {
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs from linear [m/s] and angular [rad/s] velocities
+  ConstantVelocityModel(double vx = 0, double vy = 0, double vz = 0, double
+    wx = 0, double wy = 0, double wz = 0);
+  /// Copy constructor
+  ConstantVelocityModel(const ConstantVelocityModel& other);
+  /// Assignment operator
+  ConstantVelocityModel& operator = (const ConstantVelocityModel& other);
+  /// Destructor
+  virtual ~ConstantVelocityModel();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the linear velocity [m/s]
+  const double* getLinearVelocity() const {
+    return mLinearVelocity;
+  }
+  /// Sets the linear velocity [m/s]
+  void setLinearVelocity(double vx, double vy, double vz);
+  /// Returns the angular velocity [rad/s]
+  const double* getAngularVelocity() const {
+    return mAngularVelocity;
+  }
+  /// Sets the angular velocity [rad/s]
+  void setAngularVelocity(double wx, double wy, double wz);
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Returns the sensor pose at a timestamp in the sensor frame at a reference
+  virtual Pose getRelativePose(int64_t timestamp, int64_t reference) const;
+  /** @}
+    */
+
+protected:
+  /** \name Protected members
+    @{
+    */
+  /// Linear velocity
+  double mLinearVelocity[3];
+  /// Angular velocity
+  double mAngularVelocity[3];
+  /** @}
+    */
+
+};
+
+#endif // CONSTANTVELOCITYMODEL_H
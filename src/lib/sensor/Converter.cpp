@@ -18,96 +18,863 @@
 
 #include "sensor/Converter.h"
 
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#define CONVERTER_X86
+#endif
+
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Packet accessors                                                           */
+/******************************************************************************/
+
+namespace {
+
+inline uint16_t getHeaderInfo(const DataPacket& packet, size_t chunkIdx) {
+  return packet.getDataChunk(chunkIdx).mHeaderInfo;
+}
+
+inline uint16_t getHeaderInfo(const DataPacketView& packet, size_t chunkIdx) {
+  return packet.getHeaderInfo(chunkIdx);
+}
+
+inline uint16_t getRotationalInfo(const DataPacket& packet, size_t chunkIdx) {
+  return packet.getDataChunk(chunkIdx).mRotationalInfo;
+}
+
+inline uint16_t getRotationalInfo(const DataPacketView& packet, size_t
+    chunkIdx) {
+  return packet.getRotationalInfo(chunkIdx);
+}
+
+inline uint16_t getDistance(const DataPacket& packet, size_t chunkIdx, size_t
+    laserIdx) {
+  return packet.getDataChunk(chunkIdx).mLaserData[laserIdx].mDistance;
+}
+
+inline uint16_t getDistance(const DataPacketView& packet, size_t chunkIdx,
+    size_t laserIdx) {
+  return packet.getDistance(chunkIdx, laserIdx);
+}
+
+inline uint8_t getIntensity(const DataPacket& packet, size_t chunkIdx, size_t
+    laserIdx) {
+  return packet.getDataChunk(chunkIdx).mLaserData[laserIdx].mIntensity;
+}
+
+inline uint8_t getIntensity(const DataPacketView& packet, size_t chunkIdx,
+    size_t laserIdx) {
+  return packet.getIntensity(chunkIdx, laserIdx);
+}
+
+/******************************************************************************/
+/* Azimuth lookup table                                                       */
+/******************************************************************************/
+
+/// Number of encoder ticks per revolution
+const size_t mNumRotationTicks = 360 * DataPacket::mRotationResolution;
+
+/// Angle, sinus and cosinus of every encoder tick
+struct AzimuthTable {
+  /// Angles in radians
+  float mAngle[mNumRotationTicks];
+  /// Sinus of the angles
+  float mSin[mNumRotationTicks];
+  /// Cosinus of the angles
+  float mCos[mNumRotationTicks];
+  /// Default constructor
+  AzimuthTable() {
+    for (size_t i = 0; i < mNumRotationTicks; ++i) {
+      mAngle[i] = Calibration::deg2rad(static_cast<float>(i) /
+        static_cast<float>(DataPacket::mRotationResolution));
+      mSin[i] = sin(mAngle[i]);
+      mCos[i] = cos(mAngle[i]);
+    }
+  }
+};
+
+const AzimuthTable& getAzimuthTable() {
+  static const AzimuthTable table;
+  return table;
+}
+
+template <typename P>
+size_t getRotationTick(const P& dataPacket, size_t chunkIdx) {
+  return getRotationalInfo(dataPacket, chunkIdx) % mNumRotationTicks;
+}
+
+template <typename P>
+float getRotationAngle(const P& dataPacket, size_t chunkIdx) {
+  return getAzimuthTable().mAngle[getRotationTick(dataPacket, chunkIdx)];
+}
+
+/// Wraps an angle within one turn of (-pi, pi] into (-pi, pi]
+inline float wrapAngle(float angle) {
+  if (angle > M_PI)
+    angle -= 2.0 * M_PI;
+  else if (angle <= -M_PI)
+    angle += 2.0 * M_PI;
+  return angle;
+}
+
+/******************************************************************************/
+/* Point conversion kernels                                                   */
+/******************************************************************************/
+
+/// Number of lasers in a data chunk
+const size_t mLasersPerChunk = DataPacket::DataChunk::mLasersPerPacket;
+
+/// Scale from raw distances to meters
+const float mDistanceScale = 1.0 / (DataPacket::mDistanceResolution *
+  Converter::mMeterConversion);
+
+/// Corrections of the lasers of one bank, pointing into the aligned tables of
+/// the calibration
+struct BankCorrections {
+  /// Distortion corrections in meters
+  const float* mDistCorr;
+  /// Sinus of rotation corrections
+  const float* mSinRotCorr;
+  /// Cosinus of rotation corrections
+  const float* mCosRotCorr;
+  /// Sinus of vertical corrections
+  const float* mSinVertCorr;
+  /// Cosinus of vertical corrections
+  const float* mCosVertCorr;
+  /// Horizontal offset corrections in meters
+  const float* mHorizOffsCorr;
+  /// Vertical offset corrections in meters
+  const float* mVertOffsCorr;
+  /// Minimum intensities
+  const float* mMinIntensity;
+  /// Maximum intensities
+  const float* mMaxIntensity;
+  /// Focal offsets of the intensity correction
+  const float* mFocalOffset;
+  /// Focal slopes of the intensity correction
+  const float* mFocalSlope;
+  /// Slopes of the two-point distance correction along x
+  const float* mDistCorrXSlope;
+  /// Offsets of the two-point distance correction along x in meters
+  const float* mDistCorrXOffs;
+  /// Slopes of the two-point distance correction along y
+  const float* mDistCorrYSlope;
+  /// Offsets of the two-point distance correction along y in meters
+  const float* mDistCorrYOffs;
+};
+
+/// Returns of one data chunk in structure-of-arrays layout
+struct ChunkPoints {
+  /// Raw distances on input, distances in meters on output
+  alignas(32) float mDistance[mLasersPerChunk];
+  /// Raw intensities on input, corrected intensities on output
+  alignas(32) float mIntensity[mLasersPerChunk];
+  /// X coordinates
+  alignas(32) float mX[mLasersPerChunk];
+  /// Y coordinates
+  alignas(32) float mY[mLasersPerChunk];
+  /// Z coordinates
+  alignas(32) float mZ[mLasersPerChunk];
+};
+
+/// Kernel converting the returns of a chunk, returns the mask of valid points
+typedef uint32_t (*ChunkKernel)(const BankCorrections& corrections, float
+  sinRotation, float cosRotation, float minDistance, float maxDistance,
+  ChunkPoints& points);
+
+void getBankCorrections(const Calibration& calibration, size_t idxOffs,
+    BankCorrections& corrections) {
+  if (idxOffs + mLasersPerChunk > calibration.getNumPaddedLasers())
+    throw OutOfBoundException<size_t>(idxOffs,
+      "Converter::getBankCorrections(): bank not in calibration",
+      __FILE__, __LINE__);
+  const Calibration::Tables tables = calibration.getTables();
+  corrections.mDistCorr = tables.mDistCorr + idxOffs;
+  corrections.mSinRotCorr = tables.mSinRotCorr + idxOffs;
+  corrections.mCosRotCorr = tables.mCosRotCorr + idxOffs;
+  corrections.mSinVertCorr = tables.mSinVertCorr + idxOffs;
+  corrections.mCosVertCorr = tables.mCosVertCorr + idxOffs;
+  corrections.mHorizOffsCorr = tables.mHorizOffsCorr + idxOffs;
+  corrections.mVertOffsCorr = tables.mVertOffsCorr + idxOffs;
+  corrections.mMinIntensity = tables.mMinIntensity + idxOffs;
+  corrections.mMaxIntensity = tables.mMaxIntensity + idxOffs;
+  corrections.mFocalOffset = tables.mFocalOffset + idxOffs;
+  corrections.mFocalSlope = tables.mFocalSlope + idxOffs;
+  corrections.mDistCorrXSlope = tables.mDistCorrXSlope + idxOffs;
+  corrections.mDistCorrXOffs = tables.mDistCorrXOffs + idxOffs;
+  corrections.mDistCorrYSlope = tables.mDistCorrYSlope + idxOffs;
+  corrections.mDistCorrYOffs = tables.mDistCorrYOffs + idxOffs;
+}
+
+uint32_t convertChunkScalar(const BankCorrections& c, float sinRotation,
+    float cosRotation, float minDistance, float maxDistance, ChunkPoints&
+    points) {
+  uint32_t valid = 0;
+  for (size_t j = 0; j < mLasersPerChunk; ++j) {
+    points.mIntensity[j] = Calibration::correctIntensity(points.mIntensity[j],
+      points.mDistance[j], c.mFocalOffset[j], c.mFocalSlope[j],
+      c.mMinIntensity[j], c.mMaxIntensity[j]);
+    const float distance = c.mDistCorr[j] + points.mDistance[j] *
+      mDistanceScale;
+    points.mDistance[j] = distance;
+    if ((distance < minDistance) || (distance > maxDistance))
+      continue;
+    const float sinRot = sinRotation * c.mCosRotCorr[j] -
+      cosRotation * c.mSinRotCorr[j];
+    const float cosRot = cosRotation * c.mCosRotCorr[j] +
+      sinRotation * c.mSinRotCorr[j];
+    const float xyDist = distance * c.mCosVertCorr[j] -
+      c.mVertOffsCorr[j] * c.mSinVertCorr[j];
+    const float xyDistX = xyDist * sinRot;
+    const float xyDistY = xyDist * cosRot;
+    const float x = xyDistX - c.mHorizOffsCorr[j] * cosRot;
+    const float y = xyDistY + c.mHorizOffsCorr[j] * sinRot;
+    const float distCorrX = c.mDistCorrXSlope[j] * std::fabs(xyDistX) +
+      c.mDistCorrXOffs[j];
+    const float distCorrY = c.mDistCorrYSlope[j] * std::fabs(xyDistY) +
+      c.mDistCorrYOffs[j];
+    points.mX[j] = x + distCorrX * c.mCosVertCorr[j] * sinRot;
+    points.mY[j] = y + distCorrY * c.mCosVertCorr[j] * cosRot;
+    points.mZ[j] = (distance + distCorrY) * c.mSinVertCorr[j] +
+      c.mVertOffsCorr[j] * c.mCosVertCorr[j];
+    valid |= 1u << j;
+  }
+  return valid;
+}
+
+#ifdef CONVERTER_X86
+
+__attribute__((target("sse2")))
+uint32_t convertChunkSSE2(const BankCorrections& c, float sinRotation,
+    float cosRotation, float minDistance, float maxDistance, ChunkPoints&
+    points) {
+  const __m128 sinRotation4 = _mm_set1_ps(sinRotation);
+  const __m128 cosRotation4 = _mm_set1_ps(cosRotation);
+  const __m128 minDistance4 = _mm_set1_ps(minDistance);
+  const __m128 maxDistance4 = _mm_set1_ps(maxDistance);
+  const __m128 scale4 = _mm_set1_ps(mDistanceScale);
+  const __m128 one4 = _mm_set1_ps(1.0f);
+  const __m128 focalScale4 =
+    _mm_set1_ps(1.0f / Calibration::mFocalDistanceScale);
+  const __m128 offsetScale4 = _mm_set1_ps(Calibration::mFocalOffsetScale);
+  const __m128 absMask4 = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  uint32_t valid = 0;
+  for (size_t j = 0; j < mLasersPerChunk; j += 4) {
+    const __m128 rawDistance = _mm_load_ps(points.mDistance + j);
+    const __m128 focal = _mm_sub_ps(one4, _mm_mul_ps(rawDistance,
+      focalScale4));
+    const __m128 focalTerm = _mm_and_ps(absMask4, _mm_sub_ps(
+      _mm_load_ps(c.mFocalOffset + j),
+      _mm_mul_ps(offsetScale4, _mm_mul_ps(focal, focal))));
+    const __m128 intensity = _mm_add_ps(_mm_load_ps(points.mIntensity + j),
+      _mm_mul_ps(_mm_load_ps(c.mFocalSlope + j), focalTerm));
+    _mm_store_ps(points.mIntensity + j, _mm_min_ps(_mm_max_ps(intensity,
+      _mm_load_ps(c.mMinIntensity + j)), _mm_load_ps(c.mMaxIntensity + j)));
+    const __m128 distance = _mm_add_ps(_mm_load_ps(c.mDistCorr + j),
+      _mm_mul_ps(rawDistance, scale4));
+    _mm_store_ps(points.mDistance + j, distance);
+    const __m128 mask = _mm_and_ps(_mm_cmpge_ps(distance, minDistance4),
+      _mm_cmple_ps(distance, maxDistance4));
+    const __m128 sinRotCorr = _mm_load_ps(c.mSinRotCorr + j);
+    const __m128 cosRotCorr = _mm_load_ps(c.mCosRotCorr + j);
+    const __m128 sinVertCorr = _mm_load_ps(c.mSinVertCorr + j);
+    const __m128 cosVertCorr = _mm_load_ps(c.mCosVertCorr + j);
+    const __m128 horizOffsCorr = _mm_load_ps(c.mHorizOffsCorr + j);
+    const __m128 vertOffsCorr = _mm_load_ps(c.mVertOffsCorr + j);
+    const __m128 sinRot = _mm_sub_ps(_mm_mul_ps(sinRotation4, cosRotCorr),
+      _mm_mul_ps(cosRotation4, sinRotCorr));
+    const __m128 cosRot = _mm_add_ps(_mm_mul_ps(cosRotation4, cosRotCorr),
+      _mm_mul_ps(sinRotation4, sinRotCorr));
+    const __m128 xyDist = _mm_sub_ps(_mm_mul_ps(distance, cosVertCorr),
+      _mm_mul_ps(vertOffsCorr, sinVertCorr));
+    const __m128 xyDistX = _mm_mul_ps(xyDist, sinRot);
+    const __m128 xyDistY = _mm_mul_ps(xyDist, cosRot);
+    const __m128 x = _mm_sub_ps(xyDistX, _mm_mul_ps(horizOffsCorr, cosRot));
+    const __m128 y = _mm_add_ps(xyDistY, _mm_mul_ps(horizOffsCorr, sinRot));
+    const __m128 distCorrX = _mm_add_ps(_mm_mul_ps(
+      _mm_load_ps(c.mDistCorrXSlope + j), _mm_and_ps(absMask4, xyDistX)),
+      _mm_load_ps(c.mDistCorrXOffs + j));
+    const __m128 distCorrY = _mm_add_ps(_mm_mul_ps(
+      _mm_load_ps(c.mDistCorrYSlope + j), _mm_and_ps(absMask4, xyDistY)),
+      _mm_load_ps(c.mDistCorrYOffs + j));
+    _mm_store_ps(points.mX + j, _mm_add_ps(x,
+      _mm_mul_ps(_mm_mul_ps(distCorrX, cosVertCorr), sinRot)));
+    _mm_store_ps(points.mY + j, _mm_add_ps(y,
+      _mm_mul_ps(_mm_mul_ps(distCorrY, cosVertCorr), cosRot)));
+    _mm_store_ps(points.mZ + j, _mm_add_ps(
+      _mm_mul_ps(_mm_add_ps(distance, distCorrY), sinVertCorr),
+      _mm_mul_ps(vertOffsCorr, cosVertCorr)));
+    valid |= static_cast<uint32_t>(_mm_movemask_ps(mask)) << j;
+  }
+  return valid;
+}
+
+__attribute__((target("avx2")))
+uint32_t convertChunkAVX2(const BankCorrections& c, float sinRotation,
+    float cosRotation, float minDistance, float maxDistance, ChunkPoints&
+    points) {
+  const __m256 sinRotation8 = _mm256_set1_ps(sinRotation);
+  const __m256 cosRotation8 = _mm256_set1_ps(cosRotation);
+  const __m256 minDistance8 = _mm256_set1_ps(minDistance);
+  const __m256 maxDistance8 = _mm256_set1_ps(maxDistance);
+  const __m256 scale8 = _mm256_set1_ps(mDistanceScale);
+  const __m256 one8 = _mm256_set1_ps(1.0f);
+  const __m256 focalScale8 =
+    _mm256_set1_ps(1.0f / Calibration::mFocalDistanceScale);
+  const __m256 offsetScale8 = _mm256_set1_ps(Calibration::mFocalOffsetScale);
+  const __m256 absMask8 =
+    _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  uint32_t valid = 0;
+  for (size_t j = 0; j < mLasersPerChunk; j += 8) {
+    const __m256 rawDistance = _mm256_load_ps(points.mDistance + j);
+    const __m256 focal = _mm256_sub_ps(one8, _mm256_mul_ps(rawDistance,
+      focalScale8));
+    const __m256 focalTerm = _mm256_and_ps(absMask8, _mm256_sub_ps(
+      _mm256_load_ps(c.mFocalOffset + j),
+      _mm256_mul_ps(offsetScale8, _mm256_mul_ps(focal, focal))));
+    const __m256 intensity = _mm256_add_ps(
+      _mm256_load_ps(points.mIntensity + j),
+      _mm256_mul_ps(_mm256_load_ps(c.mFocalSlope + j), focalTerm));
+    _mm256_store_ps(points.mIntensity + j, _mm256_min_ps(
+      _mm256_max_ps(intensity, _mm256_load_ps(c.mMinIntensity + j)),
+      _mm256_load_ps(c.mMaxIntensity + j)));
+    const __m256 distance = _mm256_add_ps(_mm256_load_ps(c.mDistCorr + j),
+      _mm256_mul_ps(rawDistance, scale8));
+    _mm256_store_ps(points.mDistance + j, distance);
+    const __m256 mask = _mm256_and_ps(
+      _mm256_cmp_ps(distance, minDistance8, _CMP_GE_OQ),
+      _mm256_cmp_ps(distance, maxDistance8, _CMP_LE_OQ));
+    const __m256 sinRotCorr = _mm256_load_ps(c.mSinRotCorr + j);
+    const __m256 cosRotCorr = _mm256_load_ps(c.mCosRotCorr + j);
+    const __m256 sinVertCorr = _mm256_load_ps(c.mSinVertCorr + j);
+    const __m256 cosVertCorr = _mm256_load_ps(c.mCosVertCorr + j);
+    const __m256 horizOffsCorr = _mm256_load_ps(c.mHorizOffsCorr + j);
+    const __m256 vertOffsCorr = _mm256_load_ps(c.mVertOffsCorr + j);
+    const __m256 sinRot = _mm256_sub_ps(
+      _mm256_mul_ps(sinRotation8, cosRotCorr),
+      _mm256_mul_ps(cosRotation8, sinRotCorr));
+    const __m256 cosRot = _mm256_add_ps(
+      _mm256_mul_ps(cosRotation8, cosRotCorr),
+      _mm256_mul_ps(sinRotation8, sinRotCorr));
+    const __m256 xyDist = _mm256_sub_ps(_mm256_mul_ps(distance, cosVertCorr),
+      _mm256_mul_ps(vertOffsCorr, sinVertCorr));
+    const __m256 xyDistX = _mm256_mul_ps(xyDist, sinRot);
+    const __m256 xyDistY = _mm256_mul_ps(xyDist, cosRot);
+    const __m256 x = _mm256_sub_ps(xyDistX,
+      _mm256_mul_ps(horizOffsCorr, cosRot));
+    const __m256 y = _mm256_add_ps(xyDistY,
+      _mm256_mul_ps(horizOffsCorr, sinRot));
+    const __m256 distCorrX = _mm256_add_ps(_mm256_mul_ps(
+      _mm256_load_ps(c.mDistCorrXSlope + j),
+      _mm256_and_ps(absMask8, xyDistX)),
+      _mm256_load_ps(c.mDistCorrXOffs + j));
+    const __m256 distCorrY = _mm256_add_ps(_mm256_mul_ps(
+      _mm256_load_ps(c.mDistCorrYSlope + j),
+      _mm256_and_ps(absMask8, xyDistY)),
+      _mm256_load_ps(c.mDistCorrYOffs + j));
+    _mm256_store_ps(points.mX + j, _mm256_add_ps(x,
+      _mm256_mul_ps(_mm256_mul_ps(distCorrX, cosVertCorr), sinRot)));
+    _mm256_store_ps(points.mY + j, _mm256_add_ps(y,
+      _mm256_mul_ps(_mm256_mul_ps(distCorrY, cosVertCorr), cosRot)));
+    _mm256_store_ps(points.mZ + j, _mm256_add_ps(
+      _mm256_mul_ps(_mm256_add_ps(distance, distCorrY), sinVertCorr),
+      _mm256_mul_ps(vertOffsCorr, cosVertCorr)));
+    valid |= static_cast<uint32_t>(_mm256_movemask_ps(mask)) << j;
+  }
+  return valid;
+}
+
+#endif
+
+ChunkKernel selectChunkKernel() {
+#ifdef CONVERTER_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return convertChunkAVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return convertChunkSSE2;
+#endif
+  return convertChunkScalar;
+}
+
+ChunkKernel getChunkKernel() {
+  static const ChunkKernel kernel = selectChunkKernel();
+  return kernel;
+}
+
+/// Lasers of a bank of a sensor model, each data chunk holding one bank
+template <typename S>
+struct BankLayout {
+  /// Number of lasers of a bank
+  static const size_t mNumLasers = S::mNumLasers / S::mNumBanks;
+  static_assert(mNumLasers == mLasersPerChunk,
+    "a data chunk must hold one bank of the sensor model");
+};
+
+template <typename S, typename P>
+size_t getBankOffset(const P& dataPacket, size_t chunkIdx) {
+  if ((S::mNumBanks > 1) &&
+      (getHeaderInfo(dataPacket, chunkIdx) == DataPacket::mLowerBank))
+    return BankLayout<S>::mNumLasers;
+  else
+    return 0;
+}
+
+/******************************************************************************/
+/* Firing timing                                                              */
+/******************************************************************************/
+
+/// Time offsets in seconds of every return of a packet to its timestamp,
+/// per timestamp source: the host timestamp is taken after the last firing,
+/// the GPS timestamp at the first one
+template <typename S>
+struct FiringTable {
+  /// Time offsets of the returns
+  float mOffset[2][DataPacket::mDataChunkNbr][mLasersPerChunk];
+  /// Default constructor
+  FiringTable() {
+    const size_t lastFiring = (DataPacket::mDataChunkNbr - 1) /
+      S::mChunksPerFiring * S::mFiringPeriod +
+      (BankLayout<S>::mNumLasers - 1) * S::mLaserPeriod;
+    for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i)
+      for (size_t j = 0; j < BankLayout<S>::mNumLasers; ++j) {
+        const double firing = ((i / S::mChunksPerFiring) *
+          S::mFiringPeriod + j * S::mLaserPeriod) * 1e-9;
+        mOffset[Converter::gps][i][j] = firing;
+        mOffset[Converter::host][i][j] = firing - lastFiring * 1e-9;
+      }
+  }
+};
+
+template <typename S>
+const FiringTable<S>& getFiringTable() {
+  static const FiringTable<S> table;
+  return table;
+}
+
+template <typename P, typename C>
+float getTimeOffset(const P& dataPacket, const C& cloud,
+    Converter::TimestampSource source) {
+  return (Converter::getTimestamp(dataPacket, source) -
+    cloud.getTimestamp()) * 1e-9;
+}
+
+template <typename P>
+void insertChunkPoints(const P& dataPacket, size_t idxOffs, size_t tick,
+    const ChunkPoints& points, uint32_t valid, const float* firingOffsets,
+    VdynePointCloud& pointCloud, Converter::TimestampSource source) {
+  const float timeOffset = getTimeOffset(dataPacket, pointCloud, source);
+  for (size_t j = 0; j < mLasersPerChunk; ++j) {
+    if (!(valid & (1u << j)))
+      continue;
+    VdynePointCloud::Point3D point;
+    point.mX = points.mX[j];
+    point.mY = points.mY[j];
+    point.mZ = points.mZ[j];
+    point.mIntensity = points.mIntensity[j];
+    point.mLaser = idxOffs + j;
+    point.mAzimuth = tick;
+    point.mTimeOffset = timeOffset + firingOffsets[j];
+    pointCloud.insertPoint(point);
+  }
+}
+
+template <typename P>
+void insertChunkPoints(const P& dataPacket, size_t idxOffs, size_t tick,
+    const ChunkPoints& points, uint32_t valid, const float* firingOffsets,
+    VdynePointCloudSoA& pointCloud, Converter::TimestampSource source) {
+  const float timeOffset = getTimeOffset(dataPacket, pointCloud, source);
+  for (size_t j = 0; j < mLasersPerChunk; ++j) {
+    if (!(valid & (1u << j)))
+      continue;
+    pointCloud.insertPoint(points.mX[j], points.mY[j], points.mZ[j],
+      points.mIntensity[j], idxOffs + j, tick, timeOffset + firingOffsets[j]);
+  }
+}
+
+template <typename P>
+void insertChunkPoints(const P& /*dataPacket*/, size_t idxOffs, size_t tick,
+    const ChunkPoints& points, uint32_t valid, const float*
+    /*firingOffsets*/, VdyneRangeImage& rangeImage, Converter::TimestampSource
+    /*source*/) {
+  const size_t column = rangeImage.getAzimuthColumn(tick);
+  const size_t numLasers = rangeImage.getNumLaserRows();
+  for (size_t j = 0; j < mLasersPerChunk; ++j) {
+    if (!(valid & (1u << j)) || (idxOffs + j >= numLasers))
+      continue;
+    rangeImage.setCell(rangeImage.getLaserRow(idxOffs + j), column,
+      points.mDistance[j], points.mIntensity[j], points.mX[j], points.mY[j],
+      points.mZ[j]);
+  }
+}
+
+template <typename S, typename P, typename C>
+void convertPointChunk(const P& dataPacket, size_t chunkIdx, const
+    BankCorrections& corrections, C& pointCloud, float minDistance, float
+    maxDistance, Converter::TimestampSource source) {
+  const AzimuthTable& azimuth = getAzimuthTable();
+  const size_t tick = getRotationTick(dataPacket, chunkIdx);
+  ChunkPoints points;
+  for (size_t j = 0; j < BankLayout<S>::mNumLasers; ++j) {
+    points.mDistance[j] =
+      static_cast<float>(getDistance(dataPacket, chunkIdx, j));
+    points.mIntensity[j] =
+      static_cast<float>(getIntensity(dataPacket, chunkIdx, j));
+  }
+  const uint32_t valid = getChunkKernel()(corrections, azimuth.mSin[tick],
+    azimuth.mCos[tick], minDistance, maxDistance, points);
+  insertChunkPoints(dataPacket, getBankOffset<S>(dataPacket, chunkIdx), tick,
+    points, valid, getFiringTable<S>().mOffset[source][chunkIdx], pointCloud,
+    source);
+}
+
+template <typename S, typename P, typename C>
+void convertPointChunk(const P& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, C& pointCloud, float minDistance, float
+    maxDistance, Converter::TimestampSource source) {
+  BankCorrections corrections;
+  getBankCorrections(calibration, getBankOffset<S>(dataPacket, chunkIdx),
+    corrections);
+  convertPointChunk<S>(dataPacket, chunkIdx, corrections, pointCloud,
+    minDistance, maxDistance, source);
+}
+
+template <typename S, typename P>
+void convertScanChunk(const P& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneScanCloud& scanCloud, float minDistance,
+    float maxDistance) {
+  const size_t idxOffs = getBankOffset<S>(dataPacket, chunkIdx);
+  const float rotation = getRotationAngle(dataPacket, chunkIdx);
+  for (size_t j = 0; j < BankLayout<S>::mNumLasers; ++j) {
+    size_t laserIdx = idxOffs + j;
+    const float rawDistance =
+      static_cast<float>(getDistance(dataPacket, chunkIdx, j));
+    const float distance = (calibration.getDistCorr(laserIdx) + rawDistance /
+      static_cast<float>(S::mDistanceResolution)) /
+      static_cast<float>(Converter::mMeterConversion);
+    if ((distance < minDistance) || (distance > maxDistance))
+      continue;
+    VdyneScanCloud::Scan scan;
+    scan.mRange = distance;
+    scan.mHeading = wrapAngle(wrapAngle(-rotation) +
+      calibration.getRotCorr(laserIdx));
+    scan.mPitch = calibration.getVertCorr(laserIdx);
+    scan.mIntensity = Calibration::correctIntensity(
+      getIntensity(dataPacket, chunkIdx, j), rawDistance,
+      calibration.getFocalOffset(laserIdx),
+      calibration.getFocalSlope(laserIdx),
+      calibration.getMinIntensity(laserIdx),
+      calibration.getMaxIntensity(laserIdx));
+    scanCloud.insertScan(scan);
+  }
+}
+
+template <typename S, typename P, typename C>
+void convertPointCloud(const P& dataPacket, const Calibration& calibration,
+    C& pointCloud, float minDistance, float maxDistance,
+    Converter::TimestampSource source) {
+  pointCloud.setTimestamp(Converter::getTimestamp(dataPacket, source));
+  pointCloud.setStartRotationAngle(getRotationAngle(dataPacket, 0));
+  pointCloud.setEndRotationAngle(getRotationAngle(dataPacket,
+    DataPacket::mDataChunkNbr - 1));
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i)
+    convertPointChunk<S>(dataPacket, i, calibration, pointCloud, minDistance,
+      maxDistance, source);
+}
+
+template <typename S, typename P>
+void convertScanCloud(const P& dataPacket, const Calibration& calibration,
+    VdyneScanCloud& scanCloud, float minDistance, float maxDistance,
+    Converter::TimestampSource source) {
+  scanCloud.setTimestamp(Converter::getTimestamp(dataPacket, source));
+  scanCloud.setStartRotationAngle(getRotationAngle(dataPacket, 0));
+  scanCloud.setEndRotationAngle(getRotationAngle(dataPacket,
+    DataPacket::mDataChunkNbr - 1));
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i)
+    convertScanChunk<S>(dataPacket, i, calibration, scanCloud, minDistance,
+      maxDistance);
+}
+
+/******************************************************************************/
+/* Sensor model dispatch                                                      */
+/******************************************************************************/
+
+/// Returns whether a calibration is the one of an HDL-32E
+inline bool isHDL32E(const Calibration& calibration) {
+  return calibration.getNumLasers() == HDL32E::mNumLasers;
+}
+
+/// Throws if a calibration has fewer lasers than a sensor model
+template <typename S>
+void checkCalibration(const Calibration& calibration) {
+  if (calibration.getNumLasers() < S::mNumLasers)
+    throw BadArgumentException<size_t>(calibration.getNumLasers(),
+      "Converter::checkCalibration(): too few lasers for the sensor model",
+      __FILE__, __LINE__);
+}
+
+/// Conversions for a sensor model
+template <typename S>
+struct ModelConverter {
+  /// Converts a data packet into a point cloud
+  template <typename P, typename C>
+  static void toPointCloud(const P& dataPacket, const Calibration&
+      calibration, C& pointCloud, float minDistance, float maxDistance,
+      Converter::TimestampSource source) {
+    checkCalibration<S>(calibration);
+    convertPointCloud<S>(dataPacket, calibration, pointCloud, minDistance,
+      maxDistance, source);
+  }
+  /// Converts a data chunk into a point cloud
+  template <typename P, typename C>
+  static void toPointCloud(const P& dataPacket, size_t chunkIdx, const
+      Calibration& calibration, C& pointCloud, float minDistance, float
+      maxDistance, Converter::TimestampSource source) {
+    checkCalibration<S>(calibration);
+    convertPointChunk<S>(dataPacket, chunkIdx, calibration, pointCloud,
+      minDistance, maxDistance, source);
+  }
+  /// Converts a data packet into a scan cloud
+  template <typename P>
+  static void toScanCloud(const P& dataPacket, const Calibration&
+      calibration, VdyneScanCloud& scanCloud, float minDistance, float
+      maxDistance, Converter::TimestampSource source) {
+    checkCalibration<S>(calibration);
+    convertScanCloud<S>(dataPacket, calibration, scanCloud, minDistance,
+      maxDistance, source);
+  }
+  /// Converts a data chunk into a scan cloud
+  template <typename P>
+  static void toScanCloud(const P& dataPacket, size_t chunkIdx, const
+      Calibration& calibration, VdyneScanCloud& scanCloud, float
+      minDistance, float maxDistance) {
+    checkCalibration<S>(calibration);
+    convertScanChunk<S>(dataPacket, chunkIdx, calibration, scanCloud,
+      minDistance, maxDistance);
+  }
+};
+
+/// Conversions for the sensor model of the calibration
+template <>
+struct ModelConverter<AutoSensor> {
+  /// Converts a data packet into a point cloud
+  template <typename P, typename C>
+  static void toPointCloud(const P& dataPacket, const Calibration&
+      calibration, C& pointCloud, float minDistance, float maxDistance,
+      Converter::TimestampSource source) {
+    if (isHDL32E(calibration))
+      ModelConverter<HDL32E>::toPointCloud(dataPacket, calibration,
+        pointCloud, minDistance, maxDistance, source);
+    else
+      ModelConverter<HDL64E>::toPointCloud(dataPacket, calibration,
+        pointCloud, minDistance, maxDistance, source);
+  }
+  /// Converts a data chunk into a point cloud
+  template <typename P, typename C>
+  static void toPointCloud(const P& dataPacket, size_t chunkIdx, const
+      Calibration& calibration, C& pointCloud, float minDistance, float
+      maxDistance, Converter::TimestampSource source) {
+    if (isHDL32E(calibration))
+      ModelConverter<HDL32E>::toPointCloud(dataPacket, chunkIdx,
+        calibration, pointCloud, minDistance, maxDistance, source);
+    else
+      ModelConverter<HDL64E>::toPointCloud(dataPacket, chunkIdx,
+        calibration, pointCloud, minDistance, maxDistance, source);
+  }
+  /// Converts a data packet into a scan cloud
+  template <typename P>
+  static void toScanCloud(const P& dataPacket, const Calibration&
+      calibration, VdyneScanCloud& scanCloud, float minDistance, float
+      maxDistance, Converter::TimestampSource source) {
+    if (isHDL32E(calibration))
+      ModelConverter<HDL32E>::toScanCloud(dataPacket, calibration,
+        scanCloud, minDistance, maxDistance, source);
+    else
+      ModelConverter<HDL64E>::toScanCloud(dataPacket, calibration,
+        scanCloud, minDistance, maxDistance, source);
+  }
+  /// Converts a data chunk into a scan cloud
+  template <typename P>
+  static void toScanCloud(const P& dataPacket, size_t chunkIdx, const
+      Calibration& calibration, VdyneScanCloud& scanCloud, float
+      minDistance, float maxDistance) {
+    if (isHDL32E(calibration))
+      ModelConverter<HDL32E>::toScanCloud(dataPacket, chunkIdx,
+        calibration, scanCloud, minDistance, maxDistance);
+    else
+      ModelConverter<HDL64E>::toScanCloud(dataPacket, chunkIdx,
+        calibration, scanCloud, minDistance, maxDistance);
+  }
+};
+
+}
+
 /******************************************************************************/
 /* Methods                                                                    */
 /******************************************************************************/
 
 namespace Converter {
 
-void toPointCloud(const DataPacket& dataPacket, const Calibration&
+void toPointCloud(const DataPacket& dataPacket, const Calibration& calibration,
+    VdynePointCloud& pointCloud, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, pointCloud,
+    minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacketView& dataPacket, const Calibration&
     calibration, VdynePointCloud& pointCloud, float minDistance, float
-    maxDistance) {
-  pointCloud.setTimestamp(dataPacket.getTimestamp());
-  for (size_t i = 0; i < dataPacket.mDataChunkNbr; ++i) {
-    size_t idxOffs = 0;
-    const DataPacket::DataChunk& data = dataPacket.getDataChunk(i);
-    if (data.mHeaderInfo == dataPacket.mLowerBank)
-      idxOffs = data.mLasersPerPacket;
-    const float rotation =
-      calibration.deg2rad(static_cast<float>(data.mRotationalInfo) /
-      static_cast<float>(dataPacket.mRotationResolution));
-    if (i == 0)
-      pointCloud.setStartRotationAngle(rotation);
-    else if (i == dataPacket.mDataChunkNbr -1)
-      pointCloud.setEndRotationAngle(rotation);
-    for (size_t j = 0; j < data.mLasersPerPacket; ++j) {
-      size_t laserIdx = idxOffs + j;
-      const float distance = (calibration.getDistCorr(laserIdx)
-        + static_cast<float>(data.mLaserData[j].mDistance) /
-        static_cast<float>(dataPacket.mDistanceResolution)) /
-        static_cast<float>(mMeterConversion);
-      if ((distance < minDistance) || (distance > maxDistance))
-        continue;
-      const float sinRot = sin(rotation) *
-        calibration.getCosRotCorr(laserIdx) -
-        cos(rotation) * calibration.getSinRotCorr(laserIdx);
-      const float cosRot = cos(rotation) *
-        calibration.getCosRotCorr(laserIdx) +
-        sin(rotation) * calibration.getSinRotCorr(laserIdx);
-      const float horizOffsCorr =
-        calibration.getHorizOffsCorr(laserIdx) /
-        static_cast<float>(mMeterConversion);
-      const float vertOffsCorr =
-        calibration.getVertOffsCorr(laserIdx) /
-        static_cast<float>(mMeterConversion);
-      const float xyDist = distance *
-        calibration.getCosVertCorr(laserIdx) -
-        vertOffsCorr * calibration.getSinVertCorr(laserIdx);
-      VdynePointCloud::Point3D point;
-      point.mX = xyDist * sinRot - horizOffsCorr * cosRot;
-      point.mY = xyDist * cosRot + horizOffsCorr * sinRot;
-      point.mZ = distance *
-        calibration.getSinVertCorr(laserIdx) + vertOffsCorr *
-        calibration.getCosVertCorr(laserIdx);
-      point.mIntensity = data.mLaserData[j].mIntensity;
-      pointCloud.insertPoint(point);
-    }
-  }
+    maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, pointCloud,
+    minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloud& pointCloud, float minDistance,
+    float maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    pointCloud, minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloud& pointCloud, float minDistance,
+    float maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    pointCloud, minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacket& dataPacket, const Calibration& calibration,
+    VdynePointCloudSoA& pointCloud, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, pointCloud,
+    minDistance, maxDistance, source);
 }
 
-void toScanCloud(const DataPacket& dataPacket, const Calibration&
+void toPointCloud(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdynePointCloudSoA& pointCloud, float minDistance, float
+    maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, pointCloud,
+    minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloudSoA& pointCloud, float
+    minDistance, float maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    pointCloud, minDistance, maxDistance, source);
+}
+
+void toPointCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloudSoA& pointCloud, float
+    minDistance, float maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    pointCloud, minDistance, maxDistance, source);
+}
+
+void toRangeImage(const DataPacket& dataPacket, const Calibration& calibration,
+    VdyneRangeImage& rangeImage, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, rangeImage,
+    minDistance, maxDistance, source);
+}
+
+void toRangeImage(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdyneRangeImage& rangeImage, float minDistance, float
+    maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, calibration, rangeImage,
+    minDistance, maxDistance, source);
+}
+
+void toRangeImage(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneRangeImage& rangeImage, float minDistance,
+    float maxDistance) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    rangeImage, minDistance, maxDistance, host);
+}
+
+void toRangeImage(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneRangeImage& rangeImage, float minDistance,
+    float maxDistance) {
+  ModelConverter<AutoSensor>::toPointCloud(dataPacket, chunkIdx, calibration,
+    rangeImage, minDistance, maxDistance, host);
+}
+
+void setRangeImageRows(const Calibration& calibration, VdyneRangeImage&
+    rangeImage) {
+  const size_t numLasers = calibration.getNumLasers();
+  std::vector<size_t> lasers(numLasers);
+  for (size_t i = 0; i < numLasers; ++i)
+    lasers[i] = i;
+  std::stable_sort(lasers.begin(), lasers.end(),
+    [&calibration](size_t lhs, size_t rhs) {
+      return calibration.getVertCorr(lhs) > calibration.getVertCorr(rhs);
+    });
+  std::vector<size_t> laserRows(numLasers);
+  for (size_t i = 0; i < numLasers; ++i)
+    laserRows[lasers[i]] = i;
+  rangeImage.setLaserRows(laserRows);
+}
+
+void toScanCloud(const DataPacket& dataPacket, const Calibration& calibration,
+    VdyneScanCloud& scanCloud, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<AutoSensor>::toScanCloud(dataPacket, calibration, scanCloud,
+    minDistance, maxDistance, source);
+}
+
+void toScanCloud(const DataPacketView& dataPacket, const Calibration&
     calibration, VdyneScanCloud& scanCloud, float minDistance, float
-    maxDistance) {
-  scanCloud.setTimestamp(dataPacket.getTimestamp());
-  for (size_t i = 0; i < dataPacket.mDataChunkNbr; ++i) {
-    size_t idxOffs = 0;
-    const DataPacket::DataChunk& data = dataPacket.getDataChunk(i);
-    if (data.mHeaderInfo == dataPacket.mLowerBank)
-      idxOffs = data.mLasersPerPacket;
-    const float rotation =
-      calibration.deg2rad(static_cast<float>(data.mRotationalInfo) /
-      static_cast<float>(dataPacket.mRotationResolution));
-    if (i == 0)
-      scanCloud.setStartRotationAngle(rotation);
-    else if (i == dataPacket.mDataChunkNbr -1)
-      scanCloud.setEndRotationAngle(rotation);
-    for (size_t j = 0; j < data.mLasersPerPacket; ++j) {
-      size_t laserIdx = idxOffs + j;
-      const float distance = (calibration.getDistCorr(laserIdx)
-        + static_cast<float>(data.mLaserData[j].mDistance) /
-        static_cast<float>(dataPacket.mDistanceResolution)) /
-        static_cast<float>(mMeterConversion);
-      if ((distance < minDistance) || (distance > maxDistance))
-        continue;
-      VdyneScanCloud::Scan scan;
-      scan.mRange = distance;
-      scan.mHeading = normalizeAngle(-(rotation -
-        calibration.getRotCorr(laserIdx)));
-      scan.mPitch = calibration.getVertCorr(laserIdx);
-      scan.mIntensity = data.mLaserData[j].mIntensity;
-      scanCloud.insertScan(scan);
-    }
-  }
+    maxDistance, TimestampSource source) {
+  ModelConverter<AutoSensor>::toScanCloud(dataPacket, calibration, scanCloud,
+    minDistance, maxDistance, source);
+}
+
+void toScanCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneScanCloud& scanCloud, float minDistance,
+    float maxDistance) {
+  ModelConverter<AutoSensor>::toScanCloud(dataPacket, chunkIdx, calibration,
+    scanCloud, minDistance, maxDistance);
+}
+
+void toScanCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneScanCloud& scanCloud, float minDistance,
+    float maxDistance) {
+  ModelConverter<AutoSensor>::toScanCloud(dataPacket, chunkIdx, calibration,
+    scanCloud, minDistance, maxDistance);
+}
+
+int64_t toGPSTimestamp(int64_t timestamp, uint32_t gpsTimestamp) {
+  const int64_t hour = 3600 * static_cast<int64_t>(1000000000);
+  int64_t gpsTime = timestamp - timestamp % hour +
+    static_cast<int64_t>(gpsTimestamp) * 1000;
+  if (gpsTime - timestamp > hour / 2)
+    gpsTime -= hour;
+  else if (timestamp - gpsTime > hour / 2)
+    gpsTime += hour;
+  return gpsTime;
+}
+
+int64_t getTimestamp(const DataPacket& dataPacket, TimestampSource source) {
+  if (source == gps)
+    return toGPSTimestamp(dataPacket.getTimestamp(),
+      dataPacket.getGPSTimestamp());
+  else
+    return dataPacket.getTimestamp();
+}
+
+int64_t getTimestamp(const DataPacketView& dataPacket, TimestampSource
+    source) {
+  if (source == gps)
+    return toGPSTimestamp(dataPacket.getTimestamp(),
+      dataPacket.getGPSTimestamp());
+  else
+    return dataPacket.getTimestamp();
 }
 
 float normalizeAngle(float angle) {
@@ -117,4 +884,172 @@ float normalizeAngle(float angle) {
   return value;
 }
 
+uint16_t getCutRotation(float cutAngle) {
+  return std::lround(Calibration::rad2deg(normalizeAnglePositive(cutAngle)) *
+    DataPacket::mRotationResolution) % mNumRotationTicks;
+}
+
+bool crossesCut(uint16_t rotation, uint16_t lastRotation, bool
+    hasLastRotation, uint16_t cutRotation) {
+  rotation %= mNumRotationTicks;
+  if (!hasLastRotation)
+    return rotation == cutRotation;
+  lastRotation %= mNumRotationTicks;
+  const size_t toCut = (mNumRotationTicks + cutRotation - lastRotation) %
+    mNumRotationTicks;
+  const size_t toRotation = (mNumRotationTicks + rotation - lastRotation) %
+    mNumRotationTicks;
+  return toCut && (toCut <= toRotation);
+}
+
+template <typename S, typename P, typename C>
+void toPointCloud(const P& dataPacket, const Calibration& calibration, C&
+    pointCloud, float minDistance, float maxDistance, TimestampSource source) {
+  ModelConverter<S>::toPointCloud(dataPacket, calibration, pointCloud,
+    minDistance, maxDistance, source);
+}
+
+template <typename S, typename P, typename C>
+void toPointCloud(const P& dataPacket, size_t chunkIdx, const Calibration&
+    calibration, C& pointCloud, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<S>::toPointCloud(dataPacket, chunkIdx, calibration,
+    pointCloud, minDistance, maxDistance, source);
+}
+
+template <typename S, typename P>
+void toRangeImage(const P& dataPacket, const Calibration& calibration,
+    VdyneRangeImage& rangeImage, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<S>::toPointCloud(dataPacket, calibration, rangeImage,
+    minDistance, maxDistance, source);
+}
+
+template <typename S, typename P>
+void toRangeImage(const P& dataPacket, size_t chunkIdx, const Calibration&
+    calibration, VdyneRangeImage& rangeImage, float minDistance, float
+    maxDistance) {
+  ModelConverter<S>::toPointCloud(dataPacket, chunkIdx, calibration,
+    rangeImage, minDistance, maxDistance, host);
+}
+
+template <typename S, typename P>
+void toScanCloud(const P& dataPacket, const Calibration& calibration,
+    VdyneScanCloud& scanCloud, float minDistance, float maxDistance,
+    TimestampSource source) {
+  ModelConverter<S>::toScanCloud(dataPacket, calibration, scanCloud,
+    minDistance, maxDistance, source);
+}
+
+template <typename S, typename P>
+void toScanCloud(const P& dataPacket, size_t chunkIdx, const Calibration&
+    calibration, VdyneScanCloud& scanCloud, float minDistance, float
+    maxDistance) {
+  ModelConverter<S>::toScanCloud(dataPacket, chunkIdx, calibration, scanCloud,
+    minDistance, maxDistance);
+}
+
+/******************************************************************************/
+/* Explicit instantiations                                                    */
+/******************************************************************************/
+
+template void toPointCloud<HDL64E>(const DataPacket&, const Calibration&,
+  VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacketView&, const Calibration&,
+  VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacket&, const Calibration&,
+  VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacketView&, const Calibration&,
+  VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL64E>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toRangeImage<HDL64E>(const DataPacket&, const Calibration&,
+  VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<HDL64E>(const DataPacketView&, const Calibration&,
+  VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<HDL64E>(const DataPacket&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toRangeImage<HDL64E>(const DataPacketView&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toScanCloud<HDL64E>(const DataPacket&, const Calibration&,
+  VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<HDL64E>(const DataPacketView&, const Calibration&,
+  VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<HDL64E>(const DataPacket&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+template void toScanCloud<HDL64E>(const DataPacketView&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+
+template void toPointCloud<HDL32E>(const DataPacket&, const Calibration&,
+  VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacketView&, const Calibration&,
+  VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacket&, const Calibration&,
+  VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacketView&, const Calibration&,
+  VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<HDL32E>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toRangeImage<HDL32E>(const DataPacket&, const Calibration&,
+  VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<HDL32E>(const DataPacketView&, const Calibration&,
+  VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<HDL32E>(const DataPacket&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toRangeImage<HDL32E>(const DataPacketView&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toScanCloud<HDL32E>(const DataPacket&, const Calibration&,
+  VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<HDL32E>(const DataPacketView&, const Calibration&,
+  VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<HDL32E>(const DataPacket&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+template void toScanCloud<HDL32E>(const DataPacketView&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+
+template void toPointCloud<AutoSensor>(const DataPacket&, const Calibration&,
+  VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacketView&, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacket&, const Calibration&,
+  VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacketView&, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloud&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacket&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toPointCloud<AutoSensor>(const DataPacketView&, size_t, const
+  Calibration&, VdynePointCloudSoA&, float, float, TimestampSource);
+template void toRangeImage<AutoSensor>(const DataPacket&, const Calibration&,
+  VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<AutoSensor>(const DataPacketView&, const
+  Calibration&, VdyneRangeImage&, float, float, TimestampSource);
+template void toRangeImage<AutoSensor>(const DataPacket&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toRangeImage<AutoSensor>(const DataPacketView&, size_t, const
+  Calibration&, VdyneRangeImage&, float, float);
+template void toScanCloud<AutoSensor>(const DataPacket&, const Calibration&,
+  VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<AutoSensor>(const DataPacketView&, const
+  Calibration&, VdyneScanCloud&, float, float, TimestampSource);
+template void toScanCloud<AutoSensor>(const DataPacket&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+template void toScanCloud<AutoSensor>(const DataPacketView&, size_t, const
+  Calibration&, VdyneScanCloud&, float, float);
+
 }
@@ -25,17 +25,50 @@
 #define CONVERTER_H
 
 #include <cmath>
+#include <cstdint>
 
 #include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
 #include "sensor/Calibration.h"
+#include "sensor/SensorTraits.h"
 #include "data-structures/VdynePointCloud.h"
+#include "data-structures/VdynePointCloudSoA.h"
 #include "data-structures/VdyneScanCloud.h"
+#include "data-structures/VdyneRangeImage.h"
 
 /** The Converter namespace contains utilities to convert Velodyne data packets
-     to point clouds or scan clouds.
+     to point clouds or scan clouds. Points carry their laser index, azimuth
+     tick and their time offset to the cloud timestamp, which the data chunk
+     conversions take from the cloud. The packet timestamp is either the
+     host timestamp or the GPS timestamp of the packet resolved against it,
+     as chosen by the timestamp source argument. The GPS timestamp is the
+     time of the first firing of the packet, to which the time offset of a
+     return adds its delay in the firing sequence of the sensor model. The
+     host timestamp is taken on reception, after the last firing, from which
+     the time offset of a return subtracts its advance on that firing. The
+     conversions templated on a sensor model (HDL32E, HDL64E) are
+     instantiated for DataPacket and DataPacketView, skip the bank dispatch
+     on the HDL-32E and throw a BadArgumentException for a calibration with
+     fewer lasers than the model. The other conversions, and the ones
+     templated on AutoSensor, pick the model of the calibration at runtime.
+     The range image conversions skip the lasers beyond the laser-to-row
+     table of the image.
     \brief Velodyne data packets converter
   */
 namespace Converter {
+  /** \name Types definitions
+    @{
+    */
+  /// The enum TimestampSource represents the sources of packet timestamps.
+  enum TimestampSource {
+    /// Host timestamp of the packet
+    host = 0,
+    /// GPS timestamp of the packet
+    gps = 1
+  };
+  /** @}
+    */
+
   /** \name Constants
     @{
     */
@@ -54,17 +87,136 @@ namespace Converter {
   /// The toPointCloud function converts a data packet into a point cloud
   void toPointCloud(const DataPacket& dataPacket, const Calibration&
     calibration, VdynePointCloud& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a raw packet view into a point cloud
+  void toPointCloud(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdynePointCloud& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a data chunk into a point cloud
+  void toPointCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloud& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a raw data chunk into a point cloud
+  void toPointCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloud& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a data packet into a SoA point cloud
+  void toPointCloud(const DataPacket& dataPacket, const Calibration&
+    calibration, VdynePointCloudSoA& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a raw packet into a SoA point cloud
+  void toPointCloud(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdynePointCloudSoA& pointCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a data chunk into a SoA point cloud
+  void toPointCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloudSoA& pointCloud, float
+    minDistance = Converter::mMinDistance, float maxDistance =
+    Converter::mMaxDistance, TimestampSource source = Converter::host);
+  /// The toPointCloud function converts a raw chunk into a SoA point cloud
+  void toPointCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdynePointCloudSoA& pointCloud, float
+    minDistance = Converter::mMinDistance, float maxDistance =
+    Converter::mMaxDistance, TimestampSource source = Converter::host);
+  /// The toRangeImage function converts a data packet into a range image
+  void toRangeImage(const DataPacket& dataPacket, const Calibration&
+    calibration, VdyneRangeImage& rangeImage, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toRangeImage function converts a raw packet into a range image
+  void toRangeImage(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdyneRangeImage& rangeImage, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toRangeImage function converts a data chunk into a range image
+  void toRangeImage(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneRangeImage& rangeImage, float minDistance =
     Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// The toRangeImage function converts a raw chunk into a range image
+  void toRangeImage(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneRangeImage& rangeImage, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// Orders the rows of a range image by decreasing vertical correction
+  void setRangeImageRows(const Calibration& calibration, VdyneRangeImage&
+    rangeImage);
   /// The toScanCloud function converts a data packet into a scan cloud
   void toScanCloud(const DataPacket& dataPacket, const Calibration&
+    calibration, VdyneScanCloud& scanCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toScanCloud function converts a raw packet view into a scan cloud
+  void toScanCloud(const DataPacketView& dataPacket, const Calibration&
+    calibration, VdyneScanCloud& scanCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance,
+    TimestampSource source = Converter::host);
+  /// The toScanCloud function converts a data chunk into a scan cloud
+  void toScanCloud(const DataPacket& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneScanCloud& scanCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// The toScanCloud function converts a raw data chunk into a scan cloud
+  void toScanCloud(const DataPacketView& dataPacket, size_t chunkIdx, const
+    Calibration& calibration, VdyneScanCloud& scanCloud, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// Converts a data packet into a point cloud for a sensor model
+  template <typename S, typename P, typename C>
+  void toPointCloud(const P& dataPacket, const Calibration& calibration, C&
+    pointCloud, float minDistance = Converter::mMinDistance, float
+    maxDistance = Converter::mMaxDistance, TimestampSource source =
+    Converter::host);
+  /// Converts a data chunk into a point cloud for a sensor model
+  template <typename S, typename P, typename C>
+  void toPointCloud(const P& dataPacket, size_t chunkIdx, const Calibration&
+    calibration, C& pointCloud, float minDistance = Converter::mMinDistance,
+    float maxDistance = Converter::mMaxDistance, TimestampSource source =
+    Converter::host);
+  /// Converts a data packet into a range image for a sensor model
+  template <typename S, typename P>
+  void toRangeImage(const P& dataPacket, const Calibration& calibration,
+    VdyneRangeImage& rangeImage, float minDistance = Converter::mMinDistance,
+    float maxDistance = Converter::mMaxDistance, TimestampSource source =
+    Converter::host);
+  /// Converts a data chunk into a range image for a sensor model
+  template <typename S, typename P>
+  void toRangeImage(const P& dataPacket, size_t chunkIdx, const Calibration&
+    calibration, VdyneRangeImage& rangeImage, float minDistance =
+    Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// Converts a data packet into a scan cloud for a sensor model
+  template <typename S, typename P>
+  void toScanCloud(const P& dataPacket, const Calibration& calibration,
+    VdyneScanCloud& scanCloud, float minDistance = Converter::mMinDistance,
+    float maxDistance = Converter::mMaxDistance, TimestampSource source =
+    Converter::host);
+  /// Converts a data chunk into a scan cloud for a sensor model
+  template <typename S, typename P>
+  void toScanCloud(const P& dataPacket, size_t chunkIdx, const Calibration&
     calibration, VdyneScanCloud& scanCloud, float minDistance =
     Converter::mMinDistance, float maxDistance = Converter::mMaxDistance);
+  /// Resolves a GPS timestamp [us past the hour] against a timestamp [ns]
+  int64_t toGPSTimestamp(int64_t timestamp, uint32_t gpsTimestamp);
+  /// Returns the timestamp of a data packet from a timestamp source
+  int64_t getTimestamp(const DataPacket& dataPacket, TimestampSource source =
+    Converter::host);
+  /// Returns the timestamp of a raw packet from a timestamp source
+  int64_t getTimestamp(const DataPacketView& dataPacket, TimestampSource
+    source = Converter::host);
   /// Normalize an angle positive
   inline float normalizeAnglePositive(float angle) {
     return std::fmod(std::fmod(angle, 2.0 * M_PI) + 2.0 * M_PI, 2.0 * M_PI);
   }
   /// Normalize an angle
   float normalizeAngle(float angle);
+  /// Returns the encoder rotation of a cut angle in radians
+  uint16_t getCutRotation(float cutAngle);
+  /// Checks whether the rotation of a data chunk crosses the cut rotation
+  /// since the last data chunk, or is at the cut without a last data chunk
+  bool crossesCut(uint16_t rotation, uint16_t lastRotation, bool
+    hasLastRotation, uint16_t cutRotation);
   /** @}
     */
 
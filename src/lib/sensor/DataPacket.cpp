@@ -19,10 +19,9 @@
 #include "sensor/DataPacket.h"
 
 #include <cstring>
-#include <chrono>
 
+#include "sensor/DataPacketView.h"
 #include "com/UDPConnectionServer.h"
-#include "base/BinaryBufferReader.h"
 #include "base/BinaryStreamReader.h"
 #include "base/BinaryStreamWriter.h"
 
@@ -123,6 +122,19 @@ void DataPacket::readRawPacket(BinaryReader& stream) {
   stream >> mSpinCount >> mReserved;
 }
 
+void DataPacket::readRawPacket(const DataPacketView& view) {
+  for (size_t i = 0; i < mDataChunkNbr; ++i) {
+    mData[i].mHeaderInfo = view.getHeaderInfo(i);
+    mData[i].mRotationalInfo = view.getRotationalInfo(i);
+    for (size_t j = 0; j < DataChunk::mLasersPerPacket; ++j) {
+      mData[i].mLaserData[j].mDistance = view.getDistance(i, j);
+      mData[i].mLaserData[j].mIntensity = view.getIntensity(i, j);
+    }
+  }
+  mSpinCount = view.getSpinCount();
+  mReserved = view.getReserved();
+}
+
 void DataPacket::writeRawPacket(BinaryWriter& stream) const {
   for (size_t i = 0; i < mDataChunkNbr; i++) {
     stream << mData[i].mHeaderInfo << mData[i].mRotationalInfo;
@@ -134,13 +146,19 @@ void DataPacket::writeRawPacket(BinaryWriter& stream) const {
 }
 
 void DataPacket::readBinary(UDPConnectionServer& connection) {
-  connection.read(reinterpret_cast<char*>(mRawPacket), mPacketSize);
-  auto time = std::chrono::high_resolution_clock::now();
-  mTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-    time.time_since_epoch()).count();
-  BinaryBufferReader binaryStream(reinterpret_cast<char*>(mRawPacket),
-    mPacketSize);
-  readRawPacket(binaryStream);
+  connection.read(reinterpret_cast<char*>(mRawPacket), mPacketSize,
+    mTimestamp);
+  readRawPacket(DataPacketView(mRawPacket, mTimestamp));
+}
+
+void DataPacket::readBinary(const char* buffer, int64_t timestamp) {
+  readBinary(DataPacketView(reinterpret_cast<const uint8_t*>(buffer),
+    timestamp));
+}
+
+void DataPacket::readBinary(const DataPacketView& view) {
+  mTimestamp = view.getTimestamp();
+  readRawPacket(view);
 }
 
 void DataPacket::writeBinary(std::ostream& stream) const {
@@ -149,6 +167,25 @@ void DataPacket::writeBinary(std::ostream& stream) const {
   writeRawPacket(binaryStream);
 }
 
+void DataPacket::writeBinary(uint8_t* buffer) const {
+  for (size_t i = 0; i < mDataChunkNbr; i++) {
+    memcpy(buffer, &mData[i].mHeaderInfo, sizeof(mData[i].mHeaderInfo));
+    buffer += sizeof(mData[i].mHeaderInfo);
+    memcpy(buffer, &mData[i].mRotationalInfo,
+      sizeof(mData[i].mRotationalInfo));
+    buffer += sizeof(mData[i].mRotationalInfo);
+    for (size_t j = 0; j < DataChunk::mLasersPerPacket; ++j) {
+      const LaserData& laserData = mData[i].mLaserData[j];
+      memcpy(buffer, &laserData.mDistance, sizeof(laserData.mDistance));
+      buffer += sizeof(laserData.mDistance);
+      *buffer++ = laserData.mIntensity;
+    }
+  }
+  memcpy(buffer, &mSpinCount, sizeof(mSpinCount));
+  buffer += sizeof(mSpinCount);
+  memcpy(buffer, &mReserved, sizeof(mReserved));
+}
+
 void DataPacket::readBinary(std::istream& stream) {
   BinaryStreamReader<std::istream> binaryStream(stream);
   binaryStream >> mTimestamp;
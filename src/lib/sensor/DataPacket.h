@@ -31,6 +31,7 @@
 #include "exceptions/OutOfBoundException.h"
 
 class UDPConnectionServer;
+class DataPacketView;
 class BinaryReader;
 class BinaryWriter;
 
@@ -198,8 +199,14 @@ public:
     */
   /// Binary read from UDP
   void readBinary(UDPConnectionServer& connection);
+  /// Binary read from a raw buffer received at the given timestamp
+  void readBinary(const char* buffer, int64_t timestamp);
+  /// Binary read from a raw packet view
+  void readBinary(const DataPacketView& view);
   /// Binary write into a output stream
   void writeBinary(std::ostream& stream) const;
+  /// Binary write of the raw packet into a buffer of mPacketSize bytes
+  void writeBinary(uint8_t* buffer) const;
   /// Binary read from an input stream
   void readBinary(std::istream& stream);
   /** @}
@@ -225,6 +232,8 @@ protected:
     */
   /// Read raw packet
   void readRawPacket(BinaryReader& stream);
+  /// Read raw packet from a view
+  void readRawPacket(const DataPacketView& view);
   /// Write raw packet
   void writeRawPacket(BinaryWriter& stream) const;
   /** @}
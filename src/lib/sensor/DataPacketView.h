@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file DataPacketView.h
+    \brief This file defines the DataPacketView class, which represents a
+           read-only view over a raw Velodyne data packet
+  */
+
+#ifndef DATAPACKETVIEW_H
+#define DATAPACKETVIEW_H
+
+#include <cstdint>
+
+#include "sensor/DataPacket.h"
+
+#include "exceptions/OutOfBoundException.h"
+
+/** The class DataPacketView overlays the wire layout of a Velodyne data packet
+    onto a raw byte buffer, e.g., the UDP receive buffer. No data is copied,
+    the fields are decoded from little-endian on access. The buffer must
+    outlive the view.
+    \brief Velodyne data packet view
+  */
+class DataPacketView {
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// The struct LaserData represents the wire layout of the laser data.
+  struct LaserData {
+    /// Distance measure (little-endian)
+    uint8_t mDistance[2];
+    /// Intensity of the measure
+    uint8_t mIntensity;
+  };
+  /// The struct DataChunk represents the wire layout of a data chunk.
+  struct DataChunk {
+    /// Header info (little-endian)
+    uint8_t mHeaderInfo[2];
+    /// Rotational info (little-endian)
+    uint8_t mRotationalInfo[2];
+    /// Actual laser data
+    LaserData mLaserData[DataPacket::DataChunk::mLasersPerPacket];
+  };
+  /// The struct RawPacket represents the wire layout of a data packet.
+  struct RawPacket {
+    /// Data in the packet
+    DataChunk mData[DataPacket::mDataChunkNbr];
+    /// Spin count (little-endian)
+    uint8_t mSpinCount[2];
+    /// Reserved field (little-endian)
+    uint8_t mReserved[4];
+  };
+  /** @}
+    */
+
+  /** \name Constructors/Destructor
+    @{
+    */
+  /// Constructs view from raw buffer and timestamp
+  DataPacketView(const uint8_t* buffer, int64_t timestamp = 0) :
+      mPacket(reinterpret_cast<const RawPacket*>(buffer)),
+      mTimestamp(timestamp) {}
+  /// Copy constructor
+  DataPacketView(const DataPacketView& other) :
+      mPacket(other.mPacket),
+      mTimestamp(other.mTimestamp) {}
+  /// Assignment operator
+  DataPacketView& operator = (const DataPacketView& other) {
+    if (this != &other) {
+      mPacket = other.mPacket;
+      mTimestamp = other.mTimestamp;
+    }
+    return *this;
+  }
+  /// Destructor
+  ~DataPacketView() {}
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the timestamp of the acquisition [ns]
+  int64_t getTimestamp() const {
+    return mTimestamp;
+  }
+  /// Sets the timestamp
+  void setTimestamp(int64_t timestamp) {
+    mTimestamp = timestamp;
+  }
+  /// Returns the underlying raw packet
+  const RawPacket& getRawPacket() const {
+    return *mPacket;
+  }
+  /// Returns the header info of a data chunk
+  uint16_t getHeaderInfo(size_t dataChunkIdx) const {
+    return toUInt16(getDataChunk(dataChunkIdx).mHeaderInfo);
+  }
+  /// Returns the rotational info of a data chunk
+  uint16_t getRotationalInfo(size_t dataChunkIdx) const {
+    return toUInt16(getDataChunk(dataChunkIdx).mRotationalInfo);
+  }
+  /// Returns the distance of a laser in a data chunk
+  uint16_t getDistance(size_t dataChunkIdx, size_t laserIdx) const {
+    return toUInt16(getLaserData(dataChunkIdx, laserIdx).mDistance);
+  }
+  /// Returns the intensity of a laser in a data chunk
+  uint8_t getIntensity(size_t dataChunkIdx, size_t laserIdx) const {
+    return getLaserData(dataChunkIdx, laserIdx).mIntensity;
+  }
+  /// Returns the spin count
+  uint16_t getSpinCount() const {
+    return toUInt16(mPacket->mSpinCount);
+  }
+  /// Returns the reserved stuff
+  uint32_t getReserved() const {
+    return toUInt32(mPacket->mReserved);
+  }
+  /// Returns GPS timestamp [us]
+  uint32_t getGPSTimestamp() const {
+    return static_cast<uint32_t>(toUInt16(mPacket->mSpinCount)) |
+      (static_cast<uint32_t>(toUInt16(mPacket->mReserved)) << 16);
+  }
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Decodes a little-endian 16-bit unsigned integer
+  static uint16_t toUInt16(const uint8_t* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+  }
+  /// Decodes a little-endian 32-bit unsigned integer
+  static uint32_t toUInt32(const uint8_t* bytes) {
+    return static_cast<uint32_t>(bytes[0]) |
+      (static_cast<uint32_t>(bytes[1]) << 8) |
+      (static_cast<uint32_t>(bytes[2]) << 16) |
+      (static_cast<uint32_t>(bytes[3]) << 24);
+  }
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Returns a data chunk
+  const DataChunk& getDataChunk(size_t dataChunkIdx) const {
+#ifndef NDEBUG
+    if (dataChunkIdx >= DataPacket::mDataChunkNbr)
+      throw OutOfBoundException<size_t>(dataChunkIdx,
+        "DataPacketView::getDataChunk(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return mPacket->mData[dataChunkIdx];
+  }
+  /// Returns a laser data
+  const LaserData& getLaserData(size_t dataChunkIdx, size_t laserIdx) const {
+#ifndef NDEBUG
+    if (laserIdx >= DataPacket::DataChunk::mLasersPerPacket)
+      throw OutOfBoundException<size_t>(laserIdx,
+        "DataPacketView::getLaserData(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    return getDataChunk(dataChunkIdx).mLaserData[laserIdx];
+  }
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Raw packet
+  const RawPacket* mPacket;
+  /// Timestamp of the packet in nanoseconds since the epoch
+  int64_t mTimestamp;
+  /** @}
+    */
+
+};
+
+static_assert(sizeof(DataPacketView::RawPacket) == DataPacket::mPacketSize,
+  "DataPacketView::RawPacket does not match the wire layout");
+
+#endif // DATAPACKETVIEW_H
@@ -0,0 +1,302 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/Deskewer.h"
+
+#include <cmath>
+
+#include <algorithm>
+
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Kernels                                                                    */
+/******************************************************************************/
+
+namespace {
+
+/// Number of lanes of the time offset range reductions
+const size_t mNumLanes = 8;
+
+/// Returns the time offset range of a block of points
+template <size_t N>
+void getOffsetRange(const float* __restrict__ t, float& minOffset, float&
+    maxOffset) {
+  float lanesMin[mNumLanes];
+  float lanesMax[mNumLanes];
+  for (size_t j = 0; j < mNumLanes; ++j)
+    lanesMin[j] = lanesMax[j] = t[j];
+  for (size_t i = mNumLanes; i < N; i += mNumLanes)
+    for (size_t j = 0; j < mNumLanes; ++j) {
+      lanesMin[j] = t[i + j] < lanesMin[j] ? t[i + j] : lanesMin[j];
+      lanesMax[j] = t[i + j] > lanesMax[j] ? t[i + j] : lanesMax[j];
+    }
+  minOffset = *std::min_element(lanesMin, lanesMin + mNumLanes);
+  maxOffset = *std::max_element(lanesMax, lanesMax + mNumLanes);
+}
+
+/// Returns the time offset range of a block of points
+template <size_t N>
+void getOffsetRange(const VdynePointCloud::Point3D* __restrict__ points,
+    float& minOffset, float& maxOffset) {
+  minOffset = points[0].mTimeOffset;
+  maxOffset = points[0].mTimeOffset;
+  for (size_t i = 1; i < N; ++i) {
+    minOffset = std::min(minOffset, points[i].mTimeOffset);
+    maxOffset = std::max(maxOffset, points[i].mTimeOffset);
+  }
+}
+
+/// Transforms a point with the blend of a knot transformation and its slope
+inline void transformPoint(float& x, float& y, float& z, float a, const
+    float* __restrict__ m, const float* __restrict__ d) {
+  const float px = x;
+  const float py = y;
+  const float pz = z;
+  x = m[0] * px + m[1] * py + m[2] * pz + m[3] +
+    a * (d[0] * px + d[1] * py + d[2] * pz + d[3]);
+  y = m[4] * px + m[5] * py + m[6] * pz + m[7] +
+    a * (d[4] * px + d[5] * py + d[6] * pz + d[7]);
+  z = m[8] * px + m[9] * py + m[10] * pz + m[11] +
+    a * (d[8] * px + d[9] * py + d[10] * pz + d[11]);
+}
+
+/// Transforms a block of points between the same knots and rebases their
+/// time offsets, the fixed size and spelled out body let it vectorize at -O2
+template <size_t N>
+void transformPoints(float* __restrict__ x, float* __restrict__ y, float*
+    __restrict__ z, float* __restrict__ t, const float* __restrict__ m,
+    const float* __restrict__ d, float startOffset, float invStep, float
+    rebase) {
+  for (size_t i = 0; i < N; ++i) {
+    const float a = (t[i] - startOffset) * invStep;
+    const float px = x[i];
+    const float py = y[i];
+    const float pz = z[i];
+    x[i] = m[0] * px + m[1] * py + m[2] * pz + m[3] +
+      a * (d[0] * px + d[1] * py + d[2] * pz + d[3]);
+    y[i] = m[4] * px + m[5] * py + m[6] * pz + m[7] +
+      a * (d[4] * px + d[5] * py + d[6] * pz + d[7]);
+    z[i] = m[8] * px + m[9] * py + m[10] * pz + m[11] +
+      a * (d[8] * px + d[9] * py + d[10] * pz + d[11]);
+    t[i] += rebase;
+  }
+}
+
+/// Transforms a block of points between the same knots and rebases their
+/// time offsets
+template <size_t N>
+void transformPoints(VdynePointCloud::Point3D* __restrict__ points, const
+    float* __restrict__ m, const float* __restrict__ d, float startOffset,
+    float invStep, float rebase) {
+  for (size_t i = 0; i < N; ++i) {
+    transformPoint(points[i].mX, points[i].mY, points[i].mZ,
+      (points[i].mTimeOffset - startOffset) * invStep, m, d);
+    points[i].mTimeOffset += rebase;
+  }
+}
+
+}
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+Deskewer::Deskewer(size_t numKnots) :
+    mStartOffset(0),
+    mStep(0),
+    mInvStep(0) {
+  setNumKnots(numKnots);
+}
+
+Deskewer::Deskewer(const Deskewer& other) :
+    mNumKnots(other.mNumKnots),
+    mStartOffset(other.mStartOffset),
+    mStep(other.mStep),
+    mInvStep(other.mInvStep),
+    mTransforms(other.mTransforms),
+    mSlopes(other.mSlopes),
+    mBlockRanges(other.mBlockRanges) {
+}
+
+Deskewer& Deskewer::operator = (const Deskewer& other) {
+  if (this != &other) {
+    mNumKnots = other.mNumKnots;
+    mStartOffset = other.mStartOffset;
+    mStep = other.mStep;
+    mInvStep = other.mInvStep;
+    mTransforms = other.mTransforms;
+    mSlopes = other.mSlopes;
+    mBlockRanges = other.mBlockRanges;
+  }
+  return *this;
+}
+
+Deskewer::~Deskewer() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+size_t Deskewer::getNumKnots() const {
+  return mNumKnots;
+}
+
+void Deskewer::setNumKnots(size_t numKnots) {
+  if (numKnots < 2)
+    throw BadArgumentException<size_t>(numKnots,
+      "Deskewer::setNumKnots(): at least 2 knots are required",
+      __FILE__, __LINE__);
+  mNumKnots = numKnots;
+  mTransforms.resize(12 * mNumKnots);
+  mSlopes.resize(12 * (mNumKnots - 1));
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void Deskewer::sampleKnots(const MotionModel& model, int64_t timestamp, float
+    minOffset, float maxOffset, int64_t reference) {
+  const double step = (maxOffset > minOffset) ?
+    (static_cast<double>(maxOffset) - minOffset) / (mNumKnots - 1) : 1.0;
+  mStartOffset = minOffset;
+  mStep = step;
+  mInvStep = 1.0 / step;
+  for (size_t i = 0; i < mNumKnots; ++i)
+    model.getRelativePose(timestamp + static_cast<int64_t>(
+      std::llround((minOffset + i * step) * 1e9)), reference).getMatrix(
+      &mTransforms[12 * i]);
+  for (size_t i = 0; i < mSlopes.size(); ++i)
+    mSlopes[i] = mTransforms[i + 12] - mTransforms[i];
+}
+
+size_t Deskewer::getSegment(float timeOffset) const {
+  const float segment = std::floor((timeOffset - mStartOffset) * mInvStep);
+  if (segment <= 0)
+    return 0;
+  return std::min(static_cast<size_t>(segment), mNumKnots - 2);
+}
+
+void Deskewer::transformPoint(float& x, float& y, float& z, float timeOffset)
+    const {
+  const size_t segment = getSegment(timeOffset);
+  ::transformPoint(x, y, z, (timeOffset - mStartOffset) * mInvStep -
+    segment, &mTransforms[12 * segment], &mSlopes[12 * segment]);
+}
+
+void Deskewer::deskew(VdynePointCloud& pointCloud, const MotionModel& model) {
+  deskew(pointCloud, model, pointCloud.getTimestamp());
+}
+
+void Deskewer::deskew(VdynePointCloud& pointCloud, const MotionModel& model,
+    int64_t reference) {
+  const size_t numPoints = pointCloud.getSize();
+  if (numPoints) {
+    VdynePointCloud::Point3D* points = &*pointCloud.getPointBegin();
+    const size_t numBlocks = numPoints / mBlockSize;
+    mBlockRanges.resize(2 * numBlocks);
+    float minOffset = points[0].mTimeOffset;
+    float maxOffset = points[0].mTimeOffset;
+    for (size_t i = 0; i < numBlocks; ++i) {
+      getOffsetRange<mBlockSize>(points + i * mBlockSize,
+        mBlockRanges[2 * i], mBlockRanges[2 * i + 1]);
+      minOffset = std::min(minOffset, mBlockRanges[2 * i]);
+      maxOffset = std::max(maxOffset, mBlockRanges[2 * i + 1]);
+    }
+    for (size_t i = numBlocks * mBlockSize; i < numPoints; ++i) {
+      minOffset = std::min(minOffset, points[i].mTimeOffset);
+      maxOffset = std::max(maxOffset, points[i].mTimeOffset);
+    }
+    sampleKnots(model, pointCloud.getTimestamp(), minOffset, maxOffset,
+      reference);
+    const float rebase = (pointCloud.getTimestamp() - reference) * 1e-9;
+    for (size_t i = 0; i < numBlocks; ++i) {
+      VdynePointCloud::Point3D* block = points + i * mBlockSize;
+      const size_t segment = getSegment(mBlockRanges[2 * i]);
+      if (segment == getSegment(mBlockRanges[2 * i + 1]))
+        transformPoints<mBlockSize>(block, &mTransforms[12 * segment],
+          &mSlopes[12 * segment], mStartOffset + segment * mStep, mInvStep,
+          rebase);
+      else
+        for (size_t j = 0; j < mBlockSize; ++j) {
+          transformPoint(block[j].mX, block[j].mY, block[j].mZ,
+            block[j].mTimeOffset);
+          block[j].mTimeOffset += rebase;
+        }
+    }
+    for (size_t i = numBlocks * mBlockSize; i < numPoints; ++i) {
+      transformPoint(points[i].mX, points[i].mY, points[i].mZ,
+        points[i].mTimeOffset);
+      points[i].mTimeOffset += rebase;
+    }
+  }
+  pointCloud.setTimestamp(reference);
+}
+
+void Deskewer::deskew(VdynePointCloudSoA& pointCloud, const MotionModel&
+    model) {
+  deskew(pointCloud, model, pointCloud.getTimestamp());
+}
+
+void Deskewer::deskew(VdynePointCloudSoA& pointCloud, const MotionModel&
+    model, int64_t reference) {
+  const size_t numPoints = pointCloud.getSize();
+  if (numPoints) {
+    float* x = pointCloud.getX().data();
+    float* y = pointCloud.getY().data();
+    float* z = pointCloud.getZ().data();
+    float* t = pointCloud.getTimeOffset().data();
+    const size_t numBlocks = numPoints / mBlockSize;
+    mBlockRanges.resize(2 * numBlocks);
+    float minOffset = t[0];
+    float maxOffset = t[0];
+    for (size_t i = 0; i < numBlocks; ++i) {
+      getOffsetRange<mBlockSize>(t + i * mBlockSize, mBlockRanges[2 * i],
+        mBlockRanges[2 * i + 1]);
+      minOffset = std::min(minOffset, mBlockRanges[2 * i]);
+      maxOffset = std::max(maxOffset, mBlockRanges[2 * i + 1]);
+    }
+    for (size_t i = numBlocks * mBlockSize; i < numPoints; ++i) {
+      minOffset = std::min(minOffset, t[i]);
+      maxOffset = std::max(maxOffset, t[i]);
+    }
+    sampleKnots(model, pointCloud.getTimestamp(), minOffset, maxOffset,
+      reference);
+    const float rebase = (pointCloud.getTimestamp() - reference) * 1e-9;
+    for (size_t i = 0; i < numBlocks; ++i) {
+      const size_t offs = i * mBlockSize;
+      const size_t segment = getSegment(mBlockRanges[2 * i]);
+      if (segment == getSegment(mBlockRanges[2 * i + 1]))
+        transformPoints<mBlockSize>(x + offs, y + offs, z + offs, t + offs,
+          &mTransforms[12 * segment], &mSlopes[12 * segment],
+          mStartOffset + segment * mStep, mInvStep, rebase);
+      else
+        for (size_t j = offs; j < offs + mBlockSize; ++j) {
+          transformPoint(x[j], y[j], z[j], t[j]);
+          t[j] += rebase;
+        }
+    }
+    for (size_t i = numBlocks * mBlockSize; i < numPoints; ++i) {
+      transformPoint(x[i], y[i], z[i], t[i]);
+      t[i] += rebase;
+    }
+  }
+  pointCloud.setTimestamp(reference);
+}
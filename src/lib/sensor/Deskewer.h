@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file Deskewer.h
+    \brief This file defines the Deskewer class, which compensates the sensor
+           motion within a revolution
+  */
+
+#ifndef DESKEWER_H
+#define DESKEWER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+#include "sensor/MotionModel.h"
+#include "data-structures/VdynePointCloud.h"
+#include "data-structures/VdynePointCloudSoA.h"
+
+/** The class Deskewer compensates the sensor motion within an assembled
+    revolution. Every point is moved in place to the sensor frame at a
+    reference time, using its time offset and the motion model. The model is
+    sampled at evenly spaced knots over the time span of the cloud and the
+    transformation of a point blends linearly the ones of its two knots, so
+    that blocks of points between the same knots go through a branchless
+    loop the compiler vectorizes. The cloud timestamp is then set to the
+    reference, and time offsets rebased on it. It applies to the revolutions
+    of a RevolutionAssembler, whether fed live or from a log file.
+    \brief Ego-motion compensation of point clouds
+  */
+class Deskewer {
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs the deskewer with a number of knots
+  Deskewer(size_t numKnots = 32);
+  /// Copy constructor
+  Deskewer(const Deskewer& other);
+  /// Assignment operator
+  Deskewer& operator = (const Deskewer& other);
+  /// Destructor
+  ~Deskewer();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the number of knots
+  size_t getNumKnots() const;
+  /// Sets the number of knots
+  void setNumKnots(size_t numKnots);
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Deskews a point cloud to its timestamp
+  void deskew(VdynePointCloud& pointCloud, const MotionModel& model);
+  /// Deskews a point cloud to a reference timestamp
+  void deskew(VdynePointCloud& pointCloud, const MotionModel& model, int64_t
+    reference);
+  /// Deskews a SoA point cloud to its timestamp
+  void deskew(VdynePointCloudSoA& pointCloud, const MotionModel& model);
+  /// Deskews a SoA point cloud to a reference timestamp
+  void deskew(VdynePointCloudSoA& pointCloud, const MotionModel& model,
+    int64_t reference);
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Samples the motion model at the knots over a time span
+  void sampleKnots(const MotionModel& model, int64_t timestamp, float
+    minOffset, float maxOffset, int64_t reference);
+  /// Returns the segment of a time offset
+  size_t getSegment(float timeOffset) const;
+  /// Transforms a point with the knots of its segment
+  void transformPoint(float& x, float& y, float& z, float timeOffset) const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Number of knots
+  size_t mNumKnots;
+  /// Time offset of the first knot
+  float mStartOffset;
+  /// Time between two knots
+  float mStep;
+  /// Inverse of the time between two knots
+  float mInvStep;
+  /// Row-major 3x4 transformations at the knots
+  std::vector<float> mTransforms;
+  /// Differences between the transformations of consecutive knots
+  std::vector<float> mSlopes;
+  /// Time offset ranges of the blocks of points
+  std::vector<float> mBlockRanges;
+  /** @}
+    */
+
+  /** \name Protected static members
+    @{
+    */
+  /// Number of points processed by block
+  static const size_t mBlockSize = 64;
+  /** @}
+    */
+
+};
+
+#endif // DESKEWER_H
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/LogIndex.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+
+#include "sensor/Calibration.h"
+#include "sensor/Converter.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+const char LogIndex::mMagic[8] = {'V', 'D', 'Y', 'N', 'L', 'I', 'D', 'X'};
+
+namespace {
+
+/// Sidecar file header
+struct Header {
+  /// Magic number
+  char mMagic[8];
+  /// Version
+  uint32_t mVersion;
+  /// Size of a log record
+  uint32_t mRecordSize;
+  /// Size of an entry
+  uint32_t mEntrySize;
+  /// Cut angle in encoder ticks
+  uint16_t mCutRotation;
+  /// Padding
+  char mReserved[2];
+  /// Number of indexed packets
+  uint64_t mNumPackets;
+};
+
+static_assert(sizeof(Header) == LogIndex::mHeaderSize,
+  "LogIndex: unexpected sidecar header size");
+
+bool isEarlier(const LogIndex::Entry& entry, int64_t timestamp) {
+  return entry.mTimestamp < timestamp;
+}
+
+}
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+LogIndex::LogIndex(float cutAngle) :
+    mCutRotation(Converter::getCutRotation(cutAngle)),
+    mNumPackets(0),
+    mLastRotation(0),
+    mHasLastRotation(false) {
+}
+
+LogIndex::~LogIndex() {
+  close();
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+float LogIndex::getCutAngle() const {
+  return Calibration::deg2rad(static_cast<float>(mCutRotation) /
+    static_cast<float>(DataPacket::mRotationResolution));
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+bool LogIndex::addPacket(const uint16_t* rotations, int64_t timestamp) {
+  bool started = false;
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i) {
+    if (Converter::crossesCut(rotations[i], mLastRotation, mHasLastRotation,
+        mCutRotation))
+      started = true;
+    mLastRotation = rotations[i];
+    mHasLastRotation = true;
+  }
+  if (started) {
+    Entry entry;
+    entry.mPacketIdx = mNumPackets;
+    entry.mTimestamp = timestamp;
+    mEntries.push_back(entry);
+    if (mFile.is_open())
+      writeEntry(entry);
+  }
+  ++mNumPackets;
+  return started;
+}
+
+bool LogIndex::addPacket(const DataPacket& dataPacket) {
+  uint16_t rotations[DataPacket::mDataChunkNbr];
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i)
+    rotations[i] = dataPacket.getDataChunk(i).mRotationalInfo;
+  return addPacket(rotations, dataPacket.getTimestamp());
+}
+
+bool LogIndex::addPacket(const DataPacketView& dataPacket) {
+  uint16_t rotations[DataPacket::mDataChunkNbr];
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i)
+    rotations[i] = dataPacket.getRotationalInfo(i);
+  return addPacket(rotations, dataPacket.getTimestamp());
+}
+
+void LogIndex::build(const PacketLogReader& logReader) {
+  clear();
+  for (size_t i = 0; i < logReader.getNumPackets(); ++i)
+    addPacket(logReader.getPacket(i));
+}
+
+void LogIndex::clear() {
+  mEntries.clear();
+  mNumPackets = 0;
+  mHasLastRotation = false;
+}
+
+size_t LogIndex::findRevolution(int64_t timestamp) const {
+  if (mEntries.empty())
+    throw IOException("LogIndex::findRevolution(): empty index");
+  const std::vector<Entry>::const_iterator it =
+    std::lower_bound(mEntries.begin(), mEntries.end(), timestamp, isEarlier);
+  if (it == mEntries.end())
+    return mEntries.size() - 1;
+  if ((it == mEntries.begin()) || (it->mTimestamp == timestamp))
+    return it - mEntries.begin();
+  return it - mEntries.begin() - 1;
+}
+
+void LogIndex::read(const std::string& filename) {
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    throw IOException("LogIndex::read(): could not open file");
+  Header header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (file.gcount() != sizeof(header))
+    throw IOException("LogIndex::read(): truncated header");
+  if (memcmp(header.mMagic, mMagic, sizeof(header.mMagic)))
+    throw IOException("LogIndex::read(): bad magic number");
+  if (header.mVersion != mVersion)
+    throw IOException("LogIndex::read(): unsupported version");
+  if ((header.mRecordSize != PacketLogReader::mRecordSize) ||
+      (header.mEntrySize != sizeof(Entry)))
+    throw IOException("LogIndex::read(): unexpected record size");
+  clear();
+  mCutRotation = header.mCutRotation;
+  file.seekg(0, std::ios::end);
+  const size_t numEntries = (static_cast<size_t>(file.tellg()) -
+    sizeof(header)) / sizeof(Entry);
+  file.seekg(sizeof(header), std::ios::beg);
+  mEntries.resize(numEntries);
+  if (numEntries)
+    file.read(reinterpret_cast<char*>(&mEntries[0]),
+      numEntries * sizeof(Entry));
+  if (!file)
+    throw IOException("LogIndex::read(): truncated entries");
+  if (numEntries && (mEntries.back().mPacketIdx >= header.mNumPackets))
+    throw IOException("LogIndex::read(): entries beyond indexed packets");
+  mNumPackets = header.mNumPackets;
+}
+
+void LogIndex::open(const std::string& filename) {
+  close();
+  mFile.open(filename.c_str(), std::ios::out | std::ios::binary |
+    std::ios::trunc);
+  if (!mFile.is_open())
+    throw IOException("LogIndex::open(): could not open file");
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.mMagic, mMagic, sizeof(header.mMagic));
+  header.mVersion = mVersion;
+  header.mRecordSize = PacketLogReader::mRecordSize;
+  header.mEntrySize = sizeof(Entry);
+  header.mCutRotation = mCutRotation;
+  header.mNumPackets = mNumPackets;
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!mEntries.empty())
+    mFile.write(reinterpret_cast<const char*>(&mEntries[0]),
+      mEntries.size() * sizeof(Entry));
+  mFile.flush();
+}
+
+void LogIndex::flush() {
+  if (!mFile.is_open())
+    return;
+  const uint64_t numPackets = mNumPackets;
+  mFile.seekp(offsetof(Header, mNumPackets), std::ios::beg);
+  mFile.write(reinterpret_cast<const char*>(&numPackets),
+    sizeof(numPackets));
+  mFile.seekp(0, std::ios::end);
+  mFile.flush();
+}
+
+void LogIndex::close() {
+  if (mFile.is_open()) {
+    flush();
+    mFile.close();
+  }
+}
+
+void LogIndex::writeEntry(const Entry& entry) {
+  mFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  mFile.flush();
+}
+
+std::string LogIndex::getFilename(const std::string& logFilename) {
+  return logFilename + ".idx";
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file LogIndex.h
+    \brief This file defines the LogIndex class, which indexes the revolutions
+           of a log file of Velodyne data packets
+  */
+
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketLogReader.h"
+
+#include "exceptions/OutOfBoundException.h"
+
+/** The class LogIndex indexes the revolutions of a log file of Velodyne data
+    packets by the index and the log timestamp of the packet in which each
+    revolution starts, i.e., crosses the cut angle, as RevolutionAssembler
+    does. It is built incrementally with addPacket() while logging, or
+    rebuilt from a legacy log with build(). The index is kept in a sidecar
+    file next to the log, made of a 32-byte header followed by the entries in
+    native byte order, so that entries are appended while logging and a
+    truncated index stays valid. The header holds the number of indexed
+    packets, updated by flush(), so that readers rebuild an index that does
+    not cover its log. Revolutions are then found in O(log n) by
+    timestamp. To assemble a revolution, readers should start one packet
+    before its entry, so that the assembler sees the cut angle being crossed.
+    \brief Revolution index of a log file
+  */
+class LogIndex {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  LogIndex(const LogIndex& other);
+  /// Assignment operator
+  LogIndex& operator = (const LogIndex& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// The struct Entry represents the start of a revolution.
+  struct Entry {
+    /// Index of the packet in the log file
+    uint64_t mPacketIdx;
+    /// Log timestamp of the packet
+    int64_t mTimestamp;
+  };
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs index with cut angle in radians
+  LogIndex(float cutAngle = 0.0);
+  /// Destructor
+  ~LogIndex();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the cut angle in radians
+  float getCutAngle() const;
+  /// Returns the number of indexed packets
+  size_t getNumPackets() const {
+    return mNumPackets;
+  }
+  /// Returns the number of revolutions
+  size_t getNumRevolutions() const {
+    return mEntries.size();
+  }
+  /// Returns the start of a revolution
+  const Entry& getRevolution(size_t revolutionIdx) const {
+    if (revolutionIdx >= mEntries.size())
+      throw OutOfBoundException<size_t>(revolutionIdx,
+        "LogIndex::getRevolution(): Out of bound",
+        __FILE__, __LINE__);
+    return mEntries[revolutionIdx];
+  }
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Adds the next packet of the log, returns true if a revolution starts
+  bool addPacket(const DataPacket& dataPacket);
+  /// Adds the next packet of the log, returns true if a revolution starts
+  bool addPacket(const DataPacketView& dataPacket);
+  /// Rebuilds the index of a log file
+  void build(const PacketLogReader& logReader);
+  /// Clears the index
+  void clear();
+  /// Returns the revolution in progress at a timestamp, clamped to the log
+  size_t findRevolution(int64_t timestamp) const;
+  /// Reads the index from a sidecar file, to be queried only
+  void read(const std::string& filename);
+  /// Writes the index to a sidecar file and appends the next entries to it
+  void open(const std::string& filename);
+  /// Writes the number of indexed packets to the sidecar file
+  void flush();
+  /// Stops appending to the sidecar file
+  void close();
+  /// Returns the sidecar filename of a log file
+  static std::string getFilename(const std::string& logFilename);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Magic number of the sidecar file
+  static const char mMagic[8];
+  /// Version of the sidecar file
+  static const uint32_t mVersion = 1;
+  /// Size of the header of the sidecar file
+  static const size_t mHeaderSize = 32;
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Adds the rotations of a packet
+  bool addPacket(const uint16_t* rotations, int64_t timestamp);
+  /// Appends an entry to the sidecar file
+  void writeEntry(const Entry& entry);
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Cut angle in encoder ticks
+  uint16_t mCutRotation;
+  /// Revolution starts
+  std::vector<Entry> mEntries;
+  /// Number of indexed packets
+  size_t mNumPackets;
+  /// Last rotation seen
+  uint16_t mLastRotation;
+  /// Whether a rotation has been seen
+  bool mHasLastRotation;
+  /// Sidecar file being appended
+  std::ofstream mFile;
+  /** @}
+    */
+
+};
+
+#endif // LOGINDEX_H
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file MotionModel.h
+    \brief This file defines the MotionModel class, which is an interface to
+           the sources of the sensor motion
+  */
+
+#ifndef MOTIONMODEL_H
+#define MOTIONMODEL_H
+
+#include <cstdint>
+
+#include "data-structures/Pose.h"
+
+/** The class MotionModel is an interface to the sources of the sensor motion,
+    such as a constant velocity model or an interpolated pose stream.
+    \brief Sensor motion interface
+  */
+class MotionModel {
+public:
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Default constructor
+  MotionModel() {}
+  /// Destructor
+  virtual ~MotionModel() {}
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Returns the sensor pose at a timestamp in the sensor frame at a reference
+  virtual Pose getRelativePose(int64_t timestamp, int64_t reference) const
+    = 0;
+  /** @}
+    */
+
+};
+
+#endif // MOTIONMODEL_H
@@ -0,0 +1,482 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/PacketCodec.h"
+
+#include <cstring>
+
+#include <algorithm>
+
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketLogReader.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+const char PacketCodec::mFileMagic[8] =
+  {'V', 'D', 'Y', 'N', 'L', 'O', 'G', 'Z'};
+const char PacketCodec::mBlockMagic[4] = {'V', 'L', 'Z', 'B'};
+const size_t PacketCodec::mMinRecordSize = 3 + 2 * DataPacket::mDataChunkNbr;
+
+namespace {
+
+/// Number of data chunks per packet
+const size_t mNumChunks = DataPacket::mDataChunkNbr;
+/// Number of lasers per data chunk
+const size_t mNumLasers = DataPacket::DataChunk::mLasersPerPacket;
+/// Number of banks with their own distance history, the last for others
+const size_t mNumBanks = 3;
+/// Number of bits of a distance
+const size_t mDistanceBits = 16;
+/// Number of bits of a distance width
+const size_t mDistanceWidthBits = 5;
+/// Number of bits of a laser index
+const size_t mLaserIdxBits = 5;
+/// Number of bits of a number of exceptions
+const size_t mNumExceptionsBits = 6;
+/// Number of bits of an intensity width
+const size_t mIntensityWidthBits = 4;
+
+/// Bit stream writer
+class BitWriter {
+public:
+  BitWriter(std::vector<uint8_t>& data) :
+      mData(data),
+      mBuffer(0),
+      mNumBits(0) {
+  }
+  void write(uint32_t value, size_t numBits) {
+    mBuffer |= static_cast<uint64_t>(value) << mNumBits;
+    mNumBits += numBits;
+    if (mNumBits >= 32) {
+      for (size_t i = 0; i < 4; ++i)
+        mData.push_back(static_cast<uint8_t>(mBuffer >> (8 * i)));
+      mBuffer >>= 32;
+      mNumBits -= 32;
+    }
+  }
+  void flush() {
+    for (; mNumBits > 0; mNumBits -= std::min<size_t>(mNumBits, 8)) {
+      mData.push_back(static_cast<uint8_t>(mBuffer));
+      mBuffer >>= 8;
+    }
+  }
+private:
+  std::vector<uint8_t>& mData;
+  uint64_t mBuffer;
+  size_t mNumBits;
+};
+
+/// Bit stream reader
+class BitReader {
+public:
+  BitReader(const uint8_t* data, size_t size) :
+      mData(data),
+      mEnd(data + size),
+      mBuffer(0),
+      mNumBits(0) {
+  }
+  uint32_t read(size_t numBits) {
+    while (mNumBits < numBits) {
+      if (mData == mEnd)
+        throw IOException("PacketCodec::decode(): truncated bit stream");
+      mBuffer |= static_cast<uint64_t>(*mData++) << mNumBits;
+      mNumBits += 8;
+    }
+    const uint32_t value = static_cast<uint32_t>(mBuffer &
+      ((static_cast<uint64_t>(1) << numBits) - 1));
+    mBuffer >>= numBits;
+    mNumBits -= numBits;
+    return value;
+  }
+private:
+  const uint8_t* mData;
+  const uint8_t* mEnd;
+  uint64_t mBuffer;
+  size_t mNumBits;
+};
+
+void writeVarint(std::vector<uint8_t>& data, uint64_t value) {
+  while (value >= 0x80) {
+    data.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t readVarint(const uint8_t*& data, const uint8_t* end) {
+  uint64_t value = 0;
+  for (size_t shift = 0; shift < 64; shift += 7) {
+    if (data == end)
+      throw IOException("PacketCodec::decode(): truncated varint stream");
+    const uint8_t byte = *data++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return value;
+  }
+  throw IOException("PacketCodec::decode(): invalid varint");
+}
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+    static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// Zigzag of a 16-bit difference, wrapped around
+uint16_t zigzag16(uint16_t value, uint16_t previous) {
+  const int16_t delta = static_cast<int16_t>(value - previous);
+  return static_cast<uint16_t>((static_cast<uint16_t>(delta) << 1) ^
+    (delta >> 15));
+}
+
+uint16_t unzigzag16(uint16_t value, uint16_t previous) {
+  return static_cast<uint16_t>(previous + ((value >> 1) ^ -(value & 1)));
+}
+
+size_t getWidth(uint32_t value) {
+  return value ? 32 - __builtin_clz(value) : 0;
+}
+
+size_t getBank(uint16_t headerInfo) {
+  if (headerInfo == DataPacket::mUpperBank)
+    return 0;
+  else if (headerInfo == DataPacket::mLowerBank)
+    return 1;
+  else
+    return 2;
+}
+
+/// Bit-packs the distances of a data chunk, delta-encoded against their
+/// history, as a mask of the missing returns, then the low bits of the
+/// deltas and the high bits of the few exceptions that do not fit
+void encodeDistances(BitWriter& bits, const uint16_t* distances,
+    uint16_t* history) {
+  uint32_t missing = 0;
+  uint16_t deltas[mNumLasers];
+  size_t numDeltas = 0;
+  size_t histogram[mDistanceBits + 1] = {0};
+  for (size_t i = 0; i < mNumLasers; ++i) {
+    if (!distances[i]) {
+      missing |= static_cast<uint32_t>(1) << i;
+      continue;
+    }
+    deltas[numDeltas] = zigzag16(distances[i], history[i]);
+    history[i] = distances[i];
+    ++histogram[getWidth(deltas[numDeltas++])];
+  }
+  bits.write(missing != 0, 1);
+  if (missing)
+    bits.write(missing, mNumLasers);
+  size_t width = mDistanceBits;
+  size_t numExceptions = 0;
+  size_t minCost = numDeltas * mDistanceBits;
+  size_t numAbove = 0;
+  for (size_t w = mDistanceBits; w > 0; --w) {
+    numAbove += histogram[w];
+    const size_t cost = numDeltas * (w - 1) + numAbove * (mLaserIdxBits +
+      mDistanceBits - (w - 1));
+    if (cost < minCost) {
+      minCost = cost;
+      width = w - 1;
+      numExceptions = numAbove;
+    }
+  }
+  bits.write(width, mDistanceWidthBits);
+  bits.write(numExceptions, mNumExceptionsBits);
+  const uint16_t mask = (1 << width) - 1;
+  for (size_t i = 0; i < numDeltas; ++i)
+    bits.write(deltas[i] & mask, width);
+  for (size_t i = 0; (i < numDeltas) && numExceptions; ++i)
+    if (deltas[i] >> width) {
+      bits.write(i, mLaserIdxBits);
+      bits.write(deltas[i] >> width, mDistanceBits - width);
+      --numExceptions;
+    }
+}
+
+void decodeDistances(BitReader& bits, uint16_t* distances,
+    uint16_t* history) {
+  const uint32_t missing = bits.read(1) ? bits.read(mNumLasers) : 0;
+  size_t numDeltas = 0;
+  for (size_t i = 0; i < mNumLasers; ++i)
+    if (!(missing & (static_cast<uint32_t>(1) << i)))
+      ++numDeltas;
+  const size_t width = bits.read(mDistanceWidthBits);
+  const size_t numExceptions = bits.read(mNumExceptionsBits);
+  if ((width > mDistanceBits) || (numExceptions > numDeltas))
+    throw IOException("PacketCodec::decode(): invalid distances");
+  uint16_t deltas[mNumLasers];
+  for (size_t i = 0; i < numDeltas; ++i)
+    deltas[i] = bits.read(width);
+  for (size_t i = 0; i < numExceptions; ++i) {
+    const size_t deltaIdx = bits.read(mLaserIdxBits);
+    if (deltaIdx >= numDeltas)
+      throw IOException("PacketCodec::decode(): invalid distances");
+    deltas[deltaIdx] |= bits.read(mDistanceBits - width) << width;
+  }
+  for (size_t i = 0, j = 0; i < mNumLasers; ++i) {
+    if (missing & (static_cast<uint32_t>(1) << i)) {
+      distances[i] = 0;
+      continue;
+    }
+    history[i] = unzigzag16(deltas[j++], history[i]);
+    distances[i] = history[i];
+  }
+}
+
+/// Bit-packs the intensities of a data chunk, either as is or delta-encoded
+/// against their history, whichever is narrower
+void encodeIntensities(BitWriter& bits, const uint8_t* intensities,
+    uint8_t* history) {
+  uint8_t deltas[mNumLasers];
+  uint32_t maxIntensity = 0;
+  uint32_t maxDelta = 0;
+  for (size_t i = 0; i < mNumLasers; ++i) {
+    const int8_t delta = static_cast<int8_t>(intensities[i] - history[i]);
+    deltas[i] = static_cast<uint8_t>((static_cast<uint8_t>(delta) << 1) ^
+      (delta >> 7));
+    history[i] = intensities[i];
+    maxIntensity |= intensities[i];
+    maxDelta |= deltas[i];
+  }
+  const bool delta = getWidth(maxDelta) < getWidth(maxIntensity);
+  const size_t width = getWidth(delta ? maxDelta : maxIntensity);
+  bits.write(delta, 1);
+  bits.write(width, mIntensityWidthBits);
+  for (size_t i = 0; i < mNumLasers; ++i)
+    bits.write(delta ? deltas[i] : intensities[i], width);
+}
+
+void decodeIntensities(BitReader& bits, uint8_t* intensities,
+    uint8_t* history) {
+  const bool delta = bits.read(1);
+  const size_t width = bits.read(mIntensityWidthBits);
+  if (width > 8)
+    throw IOException("PacketCodec::decode(): invalid intensities");
+  for (size_t i = 0; i < mNumLasers; ++i) {
+    const uint8_t value = bits.read(width);
+    if (delta)
+      history[i] += (value >> 1) ^ -(value & 1);
+    else
+      history[i] = value;
+    intensities[i] = history[i];
+  }
+}
+
+void putUInt16(uint8_t* data, uint16_t value) {
+  data[0] = static_cast<uint8_t>(value);
+  data[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putUInt32(uint8_t* data, uint32_t value) {
+  putUInt16(data, static_cast<uint16_t>(value));
+  putUInt16(data + 2, static_cast<uint16_t>(value >> 16));
+}
+
+}
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+PacketCodec::PacketCodec() {
+}
+
+PacketCodec::~PacketCodec() {
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void PacketCodec::encode(const uint8_t* records, size_t numRecords,
+    std::vector<uint8_t>& block) {
+  if (!numRecords)
+    return;
+  const size_t recordSize = PacketLogReader::mRecordSize;
+  BlockHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.mMagic, mBlockMagic, sizeof(header.mMagic));
+  header.mNumRecords = numRecords;
+  memcpy(&header.mFirstTimestamp, records, sizeof(int64_t));
+  memcpy(&header.mLastTimestamp, records + (numRecords - 1) * recordSize,
+    sizeof(int64_t));
+  mBytes.clear();
+  mBits.clear();
+  mBits.reserve(numRecords * recordSize);
+  BitWriter bits(mBits);
+  int64_t lastTimestamp = header.mFirstTimestamp;
+  int64_t lastTimestampDelta = 0;
+  uint16_t lastHeaderInfo[mNumChunks] = {0};
+  uint16_t lastRotationalInfo = 0;
+  uint16_t lastRotationalDelta[mNumChunks] = {0};
+  uint16_t lastDistance[mNumBanks][mNumLasers] = {{0}};
+  uint8_t lastIntensity[mNumBanks][mNumLasers] = {{0}};
+  uint16_t lastSpinCount = 0;
+  uint32_t lastReserved = 0;
+  for (size_t i = 0; i < numRecords; ++i) {
+    const uint8_t* record = records + i * recordSize;
+    int64_t timestamp;
+    memcpy(&timestamp, record, sizeof(timestamp));
+    const DataPacketView packet(record + sizeof(timestamp), timestamp);
+    const int64_t timestampDelta = timestamp - lastTimestamp;
+    writeVarint(mBytes, zigzag(timestampDelta - lastTimestampDelta));
+    lastTimestamp = timestamp;
+    lastTimestampDelta = timestampDelta;
+    for (size_t j = 0; j < mNumChunks; ++j) {
+      const uint16_t headerInfo = packet.getHeaderInfo(j);
+      writeVarint(mBytes, zigzag16(headerInfo, lastHeaderInfo[j]));
+      lastHeaderInfo[j] = headerInfo;
+      const uint16_t rotationalInfo = packet.getRotationalInfo(j);
+      const uint16_t rotationalDelta = rotationalInfo - lastRotationalInfo;
+      writeVarint(mBytes, zigzag16(rotationalDelta, lastRotationalDelta[j]));
+      lastRotationalInfo = rotationalInfo;
+      lastRotationalDelta[j] = rotationalDelta;
+      uint16_t distances[mNumLasers];
+      uint8_t intensities[mNumLasers];
+      for (size_t k = 0; k < mNumLasers; ++k) {
+        distances[k] = packet.getDistance(j, k);
+        intensities[k] = packet.getIntensity(j, k);
+      }
+      const size_t bank = getBank(headerInfo);
+      encodeDistances(bits, distances, lastDistance[bank]);
+      encodeIntensities(bits, intensities, lastIntensity[bank]);
+    }
+    const uint16_t spinCount = packet.getSpinCount();
+    writeVarint(mBytes, zigzag16(spinCount, lastSpinCount));
+    lastSpinCount = spinCount;
+    const uint32_t reserved = packet.getReserved();
+    writeVarint(mBytes, zigzag(static_cast<int32_t>(reserved -
+      lastReserved)));
+    lastReserved = reserved;
+  }
+  bits.flush();
+  std::vector<uint8_t> bytesSize;
+  writeVarint(bytesSize, mBytes.size());
+  header.mDataSize = bytesSize.size() + mBytes.size() + mBits.size();
+  const uint8_t* headerData = reinterpret_cast<const uint8_t*>(&header);
+  block.insert(block.end(), headerData, headerData + sizeof(header));
+  block.insert(block.end(), bytesSize.begin(), bytesSize.end());
+  block.insert(block.end(), mBytes.begin(), mBytes.end());
+  block.insert(block.end(), mBits.begin(), mBits.end());
+}
+
+size_t PacketCodec::decode(const uint8_t* block, size_t size,
+    uint8_t* records) {
+  BlockHeader header;
+  if (size < sizeof(header))
+    throw IOException("PacketCodec::decode(): truncated block header");
+  memcpy(&header, block, sizeof(header));
+  if (memcmp(header.mMagic, mBlockMagic, sizeof(header.mMagic)))
+    throw IOException("PacketCodec::decode(): wrong block magic number");
+  if (size < sizeof(header) + header.mDataSize)
+    throw IOException("PacketCodec::decode(): truncated block");
+  if (header.mNumRecords > header.mDataSize / mMinRecordSize)
+    throw IOException("PacketCodec::decode(): too many records");
+  const uint8_t* data = block + sizeof(header);
+  const uint8_t* end = data + header.mDataSize;
+  const uint64_t bytesSize = readVarint(data, end);
+  if (bytesSize > static_cast<uint64_t>(end - data))
+    throw IOException("PacketCodec::decode(): truncated varint stream");
+  const uint8_t* bytesEnd = data + bytesSize;
+  BitReader bits(bytesEnd, end - bytesEnd);
+  const size_t recordSize = PacketLogReader::mRecordSize;
+  int64_t lastTimestamp = header.mFirstTimestamp;
+  int64_t lastTimestampDelta = 0;
+  uint16_t lastHeaderInfo[mNumChunks] = {0};
+  uint16_t lastRotationalInfo = 0;
+  uint16_t lastRotationalDelta[mNumChunks] = {0};
+  uint16_t lastDistance[mNumBanks][mNumLasers] = {{0}};
+  uint8_t lastIntensity[mNumBanks][mNumLasers] = {{0}};
+  uint16_t lastSpinCount = 0;
+  uint32_t lastReserved = 0;
+  for (size_t i = 0; i < header.mNumRecords; ++i) {
+    uint8_t* record = records + i * recordSize;
+    const int64_t timestampDelta = lastTimestampDelta +
+      unzigzag(readVarint(data, bytesEnd));
+    const int64_t timestamp = lastTimestamp + timestampDelta;
+    memcpy(record, &timestamp, sizeof(timestamp));
+    lastTimestamp = timestamp;
+    lastTimestampDelta = timestampDelta;
+    DataPacketView::RawPacket& packet =
+      *reinterpret_cast<DataPacketView::RawPacket*>(record +
+      sizeof(timestamp));
+    for (size_t j = 0; j < mNumChunks; ++j) {
+      DataPacketView::DataChunk& chunk = packet.mData[j];
+      const uint16_t headerInfo = unzigzag16(readVarint(data, bytesEnd),
+        lastHeaderInfo[j]);
+      putUInt16(chunk.mHeaderInfo, headerInfo);
+      lastHeaderInfo[j] = headerInfo;
+      const uint16_t rotationalDelta = unzigzag16(readVarint(data, bytesEnd),
+        lastRotationalDelta[j]);
+      const uint16_t rotationalInfo = lastRotationalInfo + rotationalDelta;
+      putUInt16(chunk.mRotationalInfo, rotationalInfo);
+      lastRotationalInfo = rotationalInfo;
+      lastRotationalDelta[j] = rotationalDelta;
+      uint16_t distances[mNumLasers];
+      uint8_t intensities[mNumLasers];
+      const size_t bank = getBank(headerInfo);
+      decodeDistances(bits, distances, lastDistance[bank]);
+      decodeIntensities(bits, intensities, lastIntensity[bank]);
+      for (size_t k = 0; k < mNumLasers; ++k) {
+        putUInt16(chunk.mLaserData[k].mDistance, distances[k]);
+        chunk.mLaserData[k].mIntensity = intensities[k];
+      }
+    }
+    const uint16_t spinCount = unzigzag16(readVarint(data, bytesEnd),
+      lastSpinCount);
+    putUInt16(packet.mSpinCount, spinCount);
+    lastSpinCount = spinCount;
+    const uint32_t reserved = lastReserved +
+      static_cast<uint32_t>(unzigzag(readVarint(data, bytesEnd)));
+    putUInt32(packet.mReserved, reserved);
+    lastReserved = reserved;
+  }
+  return header.mNumRecords;
+}
+
+void PacketCodec::writeFileHeader(std::vector<uint8_t>& data) {
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.mMagic, mFileMagic, sizeof(header.mMagic));
+  header.mVersion = mVersion;
+  header.mRecordSize = PacketLogReader::mRecordSize;
+  const uint8_t* headerData = reinterpret_cast<const uint8_t*>(&header);
+  data.insert(data.end(), headerData, headerData + sizeof(header));
+}
+
+bool PacketCodec::isCompressed(const uint8_t* data, size_t size) {
+  FileHeader header;
+  if (size < sizeof(header))
+    return false;
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.mMagic, mFileMagic, sizeof(header.mMagic)))
+    return false;
+  if (header.mVersion != mVersion)
+    throw IOException("PacketCodec::isCompressed(): unsupported version");
+  if (header.mRecordSize != PacketLogReader::mRecordSize)
+    throw IOException("PacketCodec::isCompressed(): wrong record size");
+  return true;
+}
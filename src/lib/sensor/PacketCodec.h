@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file PacketCodec.h
+    \brief This file defines the PacketCodec class, which compresses blocks
+           of Velodyne log records.
+  */
+
+#ifndef PACKETCODEC_H
+#define PACKETCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+/** The class PacketCodec losslessly compresses blocks of log records, a
+    timestamp followed by the raw packet, for the compressed log format read
+    by PacketLogReader. A compressed log starts with a 32-byte file header
+    followed by independent blocks, each made of a 32-byte block header and
+    its payload, so that a block is decoded without its predecessors and a
+    truncated log keeps its complete blocks. In a block, the distances are
+    delta-encoded per laser along azimuth, i.e., against the previous return
+    of the same laser, and bit-packed per data chunk: a mask of the missing
+    returns, the low bits of the zigzagged deltas, at the width minimizing
+    the size, then the high bits of the deltas that exceed it. The
+    intensities are bit-packed per data chunk, either as is or delta-encoded
+    the same way, whichever is narrower. The timestamps, headers, rotations
+    and status bytes are delta-encoded as varints.
+    \brief Velodyne log block codec
+  */
+class PacketCodec {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  PacketCodec(const PacketCodec& other);
+  /// Assignment operator
+  PacketCodec& operator = (const PacketCodec& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// The struct FileHeader represents the header of a compressed log.
+  struct FileHeader {
+    /// Magic number
+    char mMagic[8];
+    /// Version
+    uint32_t mVersion;
+    /// Size of a decoded record
+    uint32_t mRecordSize;
+    /// Reserved
+    uint8_t mReserved[16];
+  };
+  /// The struct BlockHeader represents the header of a block.
+  struct BlockHeader {
+    /// Magic number
+    char mMagic[4];
+    /// Number of records
+    uint32_t mNumRecords;
+    /// Size of the payload
+    uint32_t mDataSize;
+    /// Reserved
+    uint32_t mReserved;
+    /// Timestamp of the first record
+    int64_t mFirstTimestamp;
+    /// Timestamp of the last record
+    int64_t mLastTimestamp;
+  };
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Default constructor
+  PacketCodec();
+  /// Destructor
+  ~PacketCodec();
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Encodes records and appends the block to a buffer
+  void encode(const uint8_t* records, size_t numRecords,
+    std::vector<uint8_t>& block);
+  /// Decodes a block into records, returns the number of records
+  size_t decode(const uint8_t* block, size_t size, uint8_t* records);
+  /// Appends the file header to a buffer
+  static void writeFileHeader(std::vector<uint8_t>& data);
+  /// Checks whether data starts with the header of a compressed log
+  static bool isCompressed(const uint8_t* data, size_t size);
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Magic number of the file header
+  static const char mFileMagic[8];
+  /// Magic number of the block header
+  static const char mBlockMagic[4];
+  /// Version of the format
+  static const uint32_t mVersion = 1;
+  /// Default number of records per block
+  static const size_t mBlockSize = 256;
+  /// Minimum size of an encoded record, one byte per varint
+  static const size_t mMinRecordSize;
+  /** @}
+    */
+
+protected:
+  /** \name Protected members
+    @{
+    */
+  /// Varint stream of the block being encoded
+  std::vector<uint8_t> mBytes;
+  /// Bit stream of the block being encoded
+  std::vector<uint8_t> mBits;
+  /** @}
+    */
+
+};
+
+#endif // PACKETCODEC_H
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/PacketLogReader.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "exceptions/SystemException.h"
+#include "exceptions/IOException.h"
+
+/******************************************************************************/
+/* Statics                                                                    */
+/******************************************************************************/
+
+namespace {
+
+bool isBefore(size_t packetIdx, const PacketLogReader::Block& block) {
+  return packetIdx < block.mPacketIdx;
+}
+
+}
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+PacketLogReader::PacketLogReader() :
+    mData(0),
+    mFileSize(0),
+    mNumPackets(0),
+    mBlockIdx(std::numeric_limits<size_t>::max()) {
+}
+
+PacketLogReader::PacketLogReader(const std::string& filename) :
+    mData(0),
+    mFileSize(0),
+    mNumPackets(0),
+    mBlockIdx(std::numeric_limits<size_t>::max()) {
+  open(filename);
+}
+
+PacketLogReader::~PacketLogReader() {
+  close();
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+void PacketLogReader::open(const std::string& filename) {
+  close();
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw SystemException(errno, "PacketLogReader::open()::open()");
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1) {
+    const int error = errno;
+    ::close(fd);
+    throw SystemException(error, "PacketLogReader::open()::fstat()");
+  }
+  const size_t fileSize = fileStat.st_size;
+  if (!fileSize) {
+    ::close(fd);
+    return;
+  }
+  void* data = mmap(0, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED)
+    throw SystemException(error, "PacketLogReader::open()::mmap()");
+  madvise(data, fileSize, MADV_SEQUENTIAL);
+  mData = static_cast<const uint8_t*>(data);
+  mFileSize = fileSize;
+  try {
+    if (PacketCodec::isCompressed(mData, mFileSize))
+      indexBlocks();
+    else
+      mNumPackets = mFileSize / mRecordSize;
+  }
+  catch (IOException& /*e*/) {
+    close();
+    throw;
+  }
+  if (!mNumPackets)
+    close();
+}
+
+void PacketLogReader::close() {
+  if (mData)
+    munmap(const_cast<uint8_t*>(mData), mFileSize);
+  mData = 0;
+  mFileSize = 0;
+  mNumPackets = 0;
+  mBlocks.clear();
+  mRecords.clear();
+  mBlockIdx = std::numeric_limits<size_t>::max();
+}
+
+void PacketLogReader::indexBlocks() {
+  size_t offset = sizeof(PacketCodec::FileHeader);
+  while (mFileSize - offset >= sizeof(PacketCodec::BlockHeader)) {
+    PacketCodec::BlockHeader header;
+    memcpy(&header, mData + offset, sizeof(header));
+    const size_t size = sizeof(header) + header.mDataSize;
+    if (memcmp(header.mMagic, PacketCodec::mBlockMagic,
+        sizeof(header.mMagic)) || !header.mNumRecords ||
+        (header.mNumRecords > header.mDataSize /
+        PacketCodec::mMinRecordSize) || (mFileSize - offset < size))
+      break;
+    Block block;
+    block.mOffset = offset;
+    block.mSize = size;
+    block.mPacketIdx = mNumPackets;
+    block.mNumPackets = header.mNumRecords;
+    mBlocks.push_back(block);
+    mNumPackets += block.mNumPackets;
+    offset += size;
+  }
+}
+
+size_t PacketLogReader::findBlock(size_t packetIdx) const {
+  return std::upper_bound(mBlocks.begin(), mBlocks.end(), packetIdx,
+    isBefore) - mBlocks.begin() - 1;
+}
+
+const uint8_t* PacketLogReader::decodeRecord(size_t packetIdx) const {
+  if ((mBlockIdx >= mBlocks.size()) ||
+      (packetIdx < mBlocks[mBlockIdx].mPacketIdx) ||
+      (packetIdx >= mBlocks[mBlockIdx].mPacketIdx +
+      mBlocks[mBlockIdx].mNumPackets)) {
+    const size_t blockIdx = findBlock(packetIdx);
+    const Block& block = mBlocks[blockIdx];
+    mBlockIdx = std::numeric_limits<size_t>::max();
+    mRecords.resize(block.mNumPackets * mRecordSize);
+    mCodec.decode(mData + block.mOffset, block.mSize, &mRecords[0]);
+    mBlockIdx = blockIdx;
+  }
+  return &mRecords[(packetIdx - mBlocks[mBlockIdx].mPacketIdx) *
+    mRecordSize];
+}
+
+void PacketLogReader::willNeed(size_t packetIdx, size_t numPackets) const {
+  if (!mData || !numPackets || (packetIdx >= mNumPackets))
+    return;
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  const size_t lastIdx = std::min(packetIdx + numPackets, mNumPackets) - 1;
+  size_t begin = packetIdx * mRecordSize;
+  size_t end = (lastIdx + 1) * mRecordSize;
+  if (!mBlocks.empty()) {
+    const Block& lastBlock = mBlocks[findBlock(lastIdx)];
+    begin = mBlocks[findBlock(packetIdx)].mOffset;
+    end = lastBlock.mOffset + lastBlock.mSize;
+  }
+  begin = begin / pageSize * pageSize;
+  madvise(const_cast<uint8_t*>(mData) + begin, end - begin, MADV_WILLNEED);
+}
@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file PacketLogReader.h
+    \brief This file defines the PacketLogReader class, which gives random
+           access to the data packets of a log file through a memory mapping
+  */
+
+#ifndef PACKETLOGREADER_H
+#define PACKETLOGREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketCodec.h"
+
+#include "exceptions/OutOfBoundException.h"
+
+/** The class PacketLogReader maps a log file of Velodyne data packets into
+    memory and exposes its records, a timestamp followed by the raw packet,
+    as a random-access sequence of DataPacketView, without any copy. The
+    mapping is advised for sequential access, and willNeed() prefetches a
+    range of records, e.g., after a seek. A truncated last record is ignored
+    and a log file without any record is left closed. The views are valid
+    until the reader is closed. Compressed logs, see PacketCodec, are read
+    the same way: their blocks are indexed when opening and decoded on
+    access, the last decoded block being cached, so that their views are
+    only valid until a packet of another block is accessed. Indexing stops
+    at a truncated block or at one announcing more records than its payload
+    can hold.
+    \brief Memory-mapped log file reader
+  */
+class PacketLogReader {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  PacketLogReader(const PacketLogReader& other);
+  /// Assignment operator
+  PacketLogReader& operator = (const PacketLogReader& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// The struct Block represents a block of a compressed log.
+  struct Block {
+    /// Offset of the block in the log file
+    size_t mOffset;
+    /// Size of the block
+    size_t mSize;
+    /// Index of the first packet of the block
+    size_t mPacketIdx;
+    /// Number of packets in the block
+    size_t mNumPackets;
+  };
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Default constructor
+  PacketLogReader();
+  /// Constructs reader and opens a log file
+  PacketLogReader(const std::string& filename);
+  /// Destructor
+  ~PacketLogReader();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns whether a log file is open
+  bool isOpen() const {
+    return mData != 0;
+  }
+  /// Returns the size of the log file
+  size_t getFileSize() const {
+    return mFileSize;
+  }
+  /// Returns the number of packets
+  size_t getNumPackets() const {
+    return mNumPackets;
+  }
+  /// Returns the size of the complete records or blocks of the log file
+  size_t getDataSize() const {
+    if (mBlocks.empty())
+      return mNumPackets * mRecordSize;
+    return mBlocks.back().mOffset + mBlocks.back().mSize;
+  }
+  /// Returns whether the log file is compressed
+  bool isCompressed() const {
+    return !mBlocks.empty();
+  }
+  /// Returns the number of blocks of a compressed log file
+  size_t getNumBlocks() const {
+    return mBlocks.size();
+  }
+  /// Returns the timestamp of a packet
+  int64_t getTimestamp(size_t packetIdx) const {
+#ifndef NDEBUG
+    if (packetIdx >= mNumPackets)
+      throw OutOfBoundException<size_t>(packetIdx,
+        "PacketLogReader::getTimestamp(): Out of bound",
+        __FILE__, __LINE__);
+#endif
+    int64_t timestamp;
+    memcpy(&timestamp, getRecord(packetIdx), sizeof(timestamp));
+    return timestamp;
+  }
+  /// Returns a view of a packet
+  DataPacketView getPacket(size_t packetIdx) const {
+    const int64_t timestamp = getTimestamp(packetIdx);
+    return DataPacketView(getRecord(packetIdx) + sizeof(int64_t), timestamp);
+  }
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Opens a log file
+  void open(const std::string& filename);
+  /// Closes the log file
+  void close();
+  /// Prefetches a range of packets
+  void willNeed(size_t packetIdx, size_t numPackets) const;
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Size of a record in the log file
+  static const size_t mRecordSize = sizeof(int64_t) + DataPacket::mPacketSize;
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Returns a record
+  const uint8_t* getRecord(size_t packetIdx) const {
+    if (mBlocks.empty())
+      return mData + packetIdx * mRecordSize;
+    return decodeRecord(packetIdx);
+  }
+  /// Returns a record of a compressed log file, decoding its block
+  const uint8_t* decodeRecord(size_t packetIdx) const;
+  /// Returns the block of a packet in a compressed log file
+  size_t findBlock(size_t packetIdx) const;
+  /// Indexes the blocks of a compressed log file
+  void indexBlocks();
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Mapped log file
+  const uint8_t* mData;
+  /// Size of the log file
+  size_t mFileSize;
+  /// Number of packets
+  size_t mNumPackets;
+  /// Blocks of a compressed log file
+  std::vector<Block> mBlocks;
+  /// Codec of a compressed log file
+  mutable PacketCodec mCodec;
+  /// Decoded block
+  mutable std::vector<uint8_t> mRecords;
+  /// Index of the decoded block
+  mutable size_t mBlockIdx;
+  /** @}
+    */
+
+};
+
+#endif // PACKETLOGREADER_H
@@ -0,0 +1,398 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/PacketLogger.h"
+
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "exceptions/SystemException.h"
+#include "exceptions/IOException.h"
+#include "exceptions/BadArgumentException.h"
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+PacketLogger::PacketLogger(const std::string& filename, size_t bufferSize,
+    size_t numBuffers, bool directIO, size_t rotationSize,
+    double rotationPeriod, double flushPeriod, bool compress) :
+    mFilename(filename),
+    mBufferSize(bufferSize),
+    mDirectIO(directIO && !compress),
+    mRotationSize(rotationSize),
+    mRotationPeriod(static_cast<int64_t>(rotationPeriod * 1e9)),
+    mFlushPeriod(flushPeriod),
+    mCompress(compress),
+    mBuffers(numBuffers),
+    mCurrentBuffer(0),
+    mFileIdx(0),
+    mFileSize(0),
+    mFileTimestamp(std::numeric_limits<int64_t>::max()),
+    mNumLogged(0),
+    mNumWritten(0),
+    mNumDropped(0),
+    mNumFailed(0),
+    mFile(-1),
+    mOpenFileIdx(0),
+    mOpenDirectIO(false) {
+  if (bufferSize == 0)
+    throw BadArgumentException<size_t>(bufferSize,
+      "PacketLogger::PacketLogger(): buffer size must be positive",
+      __FILE__, __LINE__);
+  if (numBuffers == 0)
+    throw BadArgumentException<size_t>(numBuffers,
+      "PacketLogger::PacketLogger(): number of buffers must be positive",
+      __FILE__, __LINE__);
+  if (mDirectIO)
+    mBufferSize = (mBufferSize + mBlockRecords - 1) / mBlockRecords *
+      mBlockRecords;
+  for (size_t i = 0; i < mBuffers.size(); ++i) {
+    mBuffers[i].mData.resize(mBufferSize * mRecordSize);
+    mBuffers[i].mNumRecords = 0;
+    mBuffers[i].mFileIdx = 0;
+    mFreeBuffers.push_back(&mBuffers[i]);
+  }
+  mFileSize = openFile(0);
+}
+
+PacketLogger::~PacketLogger() {
+  interrupt();
+  flush();
+  Mutex::ScopedLock lock(mWriteMutex);
+  closeFile();
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+const std::string& PacketLogger::getFilename() const {
+  return mFilename;
+}
+
+std::string PacketLogger::getFilename(size_t fileIdx) const {
+  if (fileIdx == 0)
+    return mFilename;
+  std::ostringstream filename;
+  filename << mFilename << "." << fileIdx;
+  return filename.str();
+}
+
+size_t PacketLogger::getBufferSize() const {
+  return mBufferSize;
+}
+
+size_t PacketLogger::getNumBuffers() const {
+  return mBuffers.size();
+}
+
+bool PacketLogger::getDirectIO() const {
+  return mDirectIO;
+}
+
+size_t PacketLogger::getRotationSize() const {
+  return mRotationSize;
+}
+
+double PacketLogger::getRotationPeriod() const {
+  return mRotationPeriod * 1e-9;
+}
+
+double PacketLogger::getFlushPeriod() const {
+  return mFlushPeriod;
+}
+
+bool PacketLogger::getCompress() const {
+  return mCompress;
+}
+
+size_t PacketLogger::getNumFiles() const {
+  Mutex::ScopedLock lock(mBufferMutex);
+  return mFileIdx + 1;
+}
+
+size_t PacketLogger::getNumLogged() const {
+  Mutex::ScopedLock lock(mBufferMutex);
+  return mNumLogged;
+}
+
+size_t PacketLogger::getNumWritten() const {
+  Mutex::ScopedLock lock(mBufferMutex);
+  return mNumWritten;
+}
+
+size_t PacketLogger::getNumDropped() const {
+  Mutex::ScopedLock lock(mBufferMutex);
+  return mNumDropped;
+}
+
+size_t PacketLogger::getNumFailed() const {
+  Mutex::ScopedLock lock(mBufferMutex);
+  return mNumFailed;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+bool PacketLogger::log(const DataPacket& dataPacket) {
+  const int64_t timestamp = dataPacket.getTimestamp();
+  Mutex::ScopedLock lock(mBufferMutex);
+  uint8_t* record = reserveRecord(timestamp);
+  if (!record)
+    return false;
+  memcpy(record, &timestamp, sizeof(timestamp));
+  dataPacket.writeBinary(record + sizeof(timestamp));
+  commitRecord();
+  return true;
+}
+
+bool PacketLogger::log(const DataPacketView& dataPacket) {
+  const int64_t timestamp = dataPacket.getTimestamp();
+  Mutex::ScopedLock lock(mBufferMutex);
+  uint8_t* record = reserveRecord(timestamp);
+  if (!record)
+    return false;
+  memcpy(record, &timestamp, sizeof(timestamp));
+  memcpy(record + sizeof(timestamp), &dataPacket.getRawPacket(),
+    DataPacket::mPacketSize);
+  commitRecord();
+  return true;
+}
+
+void PacketLogger::flush() {
+  mBufferMutex.lock();
+  queueBuffer();
+  mBufferMutex.unlock();
+  writeBuffers();
+}
+
+uint8_t* PacketLogger::reserveRecord(int64_t timestamp) {
+  if (mFileSize && ((mRotationSize &&
+      mFileSize + mRecordSize > mRotationSize) || (mRotationPeriod &&
+      timestamp - mFileTimestamp >= mRotationPeriod))) {
+    queueBuffer();
+    ++mFileIdx;
+    mFileSize = 0;
+    mFileTimestamp = timestamp;
+  }
+  if (!mCurrentBuffer) {
+    if (mFreeBuffers.empty()) {
+      ++mNumDropped;
+      return 0;
+    }
+    mCurrentBuffer = mFreeBuffers.front();
+    mFreeBuffers.pop_front();
+    mCurrentBuffer->mNumRecords = 0;
+    mCurrentBuffer->mFileIdx = mFileIdx;
+  }
+  if (timestamp < mFileTimestamp)
+    mFileTimestamp = timestamp;
+  return &mCurrentBuffer->mData[mCurrentBuffer->mNumRecords * mRecordSize];
+}
+
+void PacketLogger::commitRecord() {
+  ++mCurrentBuffer->mNumRecords;
+  mFileSize += mRecordSize;
+  ++mNumLogged;
+  if (mCurrentBuffer->mNumRecords == mBufferSize)
+    queueBuffer();
+}
+
+void PacketLogger::queueBuffer() {
+  if (!mCurrentBuffer)
+    return;
+  if (mCurrentBuffer->mNumRecords) {
+    mFullBuffers.push_back(mCurrentBuffer);
+    mBufferQueued.signal();
+  }
+  else
+    mFreeBuffers.push_back(mCurrentBuffer);
+  mCurrentBuffer = 0;
+}
+
+void PacketLogger::writeBuffers() {
+  Mutex::ScopedLock writeLock(mWriteMutex);
+  mBufferMutex.lock();
+  while (!mFullBuffers.empty()) {
+    Buffer* buffer = mFullBuffers.front();
+    mFullBuffers.pop_front();
+    mBufferMutex.unlock();
+    const bool written = writeBuffer(*buffer);
+    mBufferMutex.lock();
+    if (written)
+      mNumWritten += buffer->mNumRecords;
+    else
+      mNumFailed += buffer->mNumRecords;
+    mFreeBuffers.push_back(buffer);
+  }
+  mBufferMutex.unlock();
+}
+
+bool PacketLogger::writeBuffer(const Buffer& buffer) {
+  if (mFile == -1 || buffer.mFileIdx != mOpenFileIdx) {
+    closeFile();
+    try {
+      openFile(buffer.mFileIdx);
+    }
+    catch (SystemException& /*e*/) {
+      return false;
+    }
+    catch (IOException& /*e*/) {
+      closeFile();
+      return false;
+    }
+  }
+  const off_t offset = lseek(mFile, 0, SEEK_END);
+  if (offset == -1) {
+    closeFile();
+    return false;
+  }
+  if (!writeRecords(buffer)) {
+    // a partial write would misalign the next records, the buffer is
+    // discarded and the file reopened if it cannot be cut back
+    if (ftruncate(mFile, offset) == -1)
+      closeFile();
+    return false;
+  }
+  for (size_t i = 0; i < buffer.mNumRecords; ++i) {
+    const uint8_t* record = &buffer.mData[i * mRecordSize];
+    int64_t timestamp;
+    memcpy(&timestamp, record, sizeof(timestamp));
+    mLogIndex.addPacket(DataPacketView(record + sizeof(timestamp),
+      timestamp));
+  }
+  mLogIndex.flush();
+  return true;
+}
+
+bool PacketLogger::writeRecords(const Buffer& buffer) {
+  const uint8_t* data = &buffer.mData[0];
+  size_t size = buffer.mNumRecords * mRecordSize;
+  if (mCompress) {
+    const size_t blockSize = PacketCodec::mBlockSize;
+    mCompressedData.clear();
+    for (size_t i = 0; i < buffer.mNumRecords; i += blockSize)
+      mCodec.encode(data + i * mRecordSize, std::min(blockSize,
+        buffer.mNumRecords - i), mCompressedData);
+    data = &mCompressedData[0];
+    size = mCompressedData.size();
+  }
+  if (mOpenDirectIO) {
+    const size_t directSize = size / mDirectIOAlignment * mDirectIOAlignment;
+    if (!writeData(data, directSize))
+      return false;
+    if (directSize < size) {
+      // the tail leaves the file unaligned, the rest of it is buffered
+      const int flags = fcntl(mFile, F_GETFL);
+      if (flags == -1 || fcntl(mFile, F_SETFL, flags & ~O_DIRECT) == -1)
+        return false;
+      mOpenDirectIO = false;
+    }
+    data += directSize;
+    size -= directSize;
+  }
+  return writeData(data, size);
+}
+
+bool PacketLogger::writeData(const uint8_t* data, size_t size) {
+  while (size) {
+    const ssize_t ret = ::write(mFile, data, size);
+    if (ret == -1) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data += ret;
+    size -= ret;
+  }
+  return true;
+}
+
+size_t PacketLogger::openFile(size_t fileIdx) {
+  const std::string filename = getFilename(fileIdx);
+  mLogIndex.clear();
+  size_t fileSize = 0;
+  try {
+    PacketLogReader logReader(filename);
+    if (logReader.isOpen() && (logReader.isCompressed() != mCompress))
+      throw IOException("PacketLogger::openFile(): wrong log format");
+    mLogIndex.build(logReader);
+    fileSize = logReader.getDataSize();
+  }
+  catch (SystemException& /*e*/) {
+  }
+  const int flags = O_WRONLY | O_CREAT | O_APPEND;
+  mOpenDirectIO = mDirectIO && !(fileSize % mDirectIOAlignment);
+  if (mOpenDirectIO)
+    mFile = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+  if (!mOpenDirectIO || (mFile == -1 && errno == EINVAL)) {
+    mOpenDirectIO = false;
+    mFile = ::open(filename.c_str(), flags, 0644);
+  }
+  if (mFile == -1)
+    throw SystemException(errno, "PacketLogger::openFile()::open()");
+  // drop a partial tail left by a crash, so that appended records line up
+  if (ftruncate(mFile, fileSize) == -1) {
+    const int error = errno;
+    closeFile();
+    throw SystemException(error, "PacketLogger::openFile()::ftruncate()");
+  }
+  mOpenFileIdx = fileIdx;
+  if (mCompress && !fileSize) {
+    std::vector<uint8_t> header;
+    PacketCodec::writeFileHeader(header);
+    if (!writeData(&header[0], header.size())) {
+      const int error = errno;
+      closeFile();
+      throw SystemException(error, "PacketLogger::openFile()::write()");
+    }
+  }
+  mLogIndex.open(LogIndex::getFilename(filename));
+  return fileSize;
+}
+
+void PacketLogger::closeFile() {
+  if (mFile != -1) {
+    ::close(mFile);
+    mFile = -1;
+  }
+  mLogIndex.close();
+}
+
+void PacketLogger::process() {
+  mBufferMutex.lock();
+  if (mFullBuffers.empty() && !mBufferQueued.wait(mBufferMutex,
+      mFlushPeriod) && !mDirectIO)
+    queueBuffer();
+  mBufferMutex.unlock();
+  writeBuffers();
+}
+
+void PacketLogger::cleanup() {
+  flush();
+  Thread::cleanup();
+}
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file PacketLogger.h
+    \brief This file defines the PacketLogger class, which logs Velodyne data
+           packets from a writer thread.
+  */
+
+#ifndef PACKETLOGGER_H
+#define PACKETLOGGER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "base/Thread.h"
+#include "base/Mutex.h"
+#include "base/Condition.h"
+#include "data-structures/AlignedAllocator.h"
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/PacketCodec.h"
+#include "sensor/LogIndex.h"
+
+/** The class PacketLogger logs Velodyne data packets in the format read by
+    PacketLogReader. The caller copies each record into the current buffer of
+    a fixed set of preallocated, page-aligned buffers and never blocks on the
+    disk: full buffers are written by the logger's thread to a file that stays
+    open. When all buffers are in use, records are dropped and accounted for.
+    Buffers hold a whole number of records and, when full, a whole number of
+    pages, so that the file may be written with O_DIRECT. Partial buffers are
+    flushed after the flush period, except with O_DIRECT, where they are only
+    flushed when the file is rotated or closed. The file is rotated when it
+    would exceed a size or span a duration, the next files being suffixed by
+    their number. A buffer that fails to be written is discarded whole, the
+    file being cut back to its previous end, and its records are accounted
+    for as failed. Each file is indexed by a LogIndex sidecar. Optionally, the
+    files are compressed by the logger's thread with PacketCodec, in which
+    case they are not written with O_DIRECT and the rotation size counts
+    uncompressed bytes.
+    \brief Velodyne data packets logger
+  */
+class PacketLogger :
+  public Thread {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  PacketLogger(const PacketLogger& other);
+  /// Assignment operator
+  PacketLogger& operator = (const PacketLogger& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Buffer data type, page-aligned for O_DIRECT
+  typedef std::vector<uint8_t, AlignedAllocator<uint8_t, 4096> > Data;
+  /// The struct Buffer represents a buffer of records.
+  struct Buffer {
+    /// Records
+    Data mData;
+    /// Number of records
+    size_t mNumRecords;
+    /// File the records belong to
+    size_t mFileIdx;
+  };
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs logger with log file, buffers, rotation and flush options
+  PacketLogger(const std::string& filename, size_t bufferSize = 2048,
+    size_t numBuffers = 8, bool directIO = false, size_t rotationSize = 0,
+    double rotationPeriod = 0.0, double flushPeriod = 1.0,
+    bool compress = false);
+  /// Destructor
+  virtual ~PacketLogger();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the log filename
+  const std::string& getFilename() const;
+  /// Returns the filename of a log file
+  std::string getFilename(size_t fileIdx) const;
+  /// Returns the number of records per buffer
+  size_t getBufferSize() const;
+  /// Returns the number of buffers
+  size_t getNumBuffers() const;
+  /// Returns whether the files are written with O_DIRECT
+  bool getDirectIO() const;
+  /// Returns the rotation size in bytes, 0 if disabled
+  size_t getRotationSize() const;
+  /// Returns the rotation period in seconds, 0 if disabled
+  double getRotationPeriod() const;
+  /// Returns the flush period in seconds
+  double getFlushPeriod() const;
+  /// Returns whether the files are compressed
+  bool getCompress() const;
+  /// Returns the number of files
+  size_t getNumFiles() const;
+  /// Returns the number of logged records
+  size_t getNumLogged() const;
+  /// Returns the number of records written to disk
+  size_t getNumWritten() const;
+  /// Returns the number of records dropped for lack of buffers
+  size_t getNumDropped() const;
+  /// Returns the number of records lost in write errors
+  size_t getNumFailed() const;
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Logs a data packet, returns false if it is dropped
+  bool log(const DataPacket& dataPacket);
+  /// Logs a data packet view, returns false if it is dropped
+  bool log(const DataPacketView& dataPacket);
+  /// Writes all buffered records to the log file
+  void flush();
+  /** @}
+    */
+
+  /** \name Public members
+    @{
+    */
+  /// Record size
+  static const size_t mRecordSize = PacketLogReader::mRecordSize;
+  /// Alignment of O_DIRECT writes
+  static const size_t mDirectIOAlignment = 4096;
+  /// Number of records per buffer block, a whole number of O_DIRECT blocks
+  static const size_t mBlockRecords = 2048;
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Do computational processing
+  virtual void process();
+  /// Do cleanup
+  virtual void cleanup();
+  /// Reserves a record in the current buffer, returns 0 if none is free
+  uint8_t* reserveRecord(int64_t timestamp);
+  /// Commits the reserved record
+  void commitRecord();
+  /// Queues the current buffer for writing
+  void queueBuffer();
+  /// Writes the queued buffers
+  void writeBuffers();
+  /// Writes a buffer to its log file, returns false on error
+  bool writeBuffer(const Buffer& buffer);
+  /// Writes the records of a buffer to the open log file, returns false on
+  /// error
+  bool writeRecords(const Buffer& buffer);
+  /// Writes data to the open log file, returns false on error
+  bool writeData(const uint8_t* data, size_t size);
+  /// Opens a log file, truncated to its complete records, returns its size
+  size_t openFile(size_t fileIdx);
+  /// Closes the log file
+  void closeFile();
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Log filename
+  std::string mFilename;
+  /// Number of records per buffer
+  size_t mBufferSize;
+  /// Whether the files are written with O_DIRECT
+  bool mDirectIO;
+  /// Rotation size in bytes
+  size_t mRotationSize;
+  /// Rotation period in nanoseconds
+  int64_t mRotationPeriod;
+  /// Flush period in seconds
+  double mFlushPeriod;
+  /// Whether the files are compressed
+  bool mCompress;
+  /// Preallocated buffers
+  std::vector<Buffer> mBuffers;
+  /// Free buffers
+  std::list<Buffer*> mFreeBuffers;
+  /// Buffers queued for writing
+  std::list<Buffer*> mFullBuffers;
+  /// Buffer being filled
+  Buffer* mCurrentBuffer;
+  /// Number of the file being filled
+  size_t mFileIdx;
+  /// Size of the file being filled
+  size_t mFileSize;
+  /// Timestamp of the first record of the file being filled
+  int64_t mFileTimestamp;
+  /// Number of records logged
+  size_t mNumLogged;
+  /// Number of records written
+  size_t mNumWritten;
+  /// Number of records dropped
+  size_t mNumDropped;
+  /// Number of records lost in write errors
+  size_t mNumFailed;
+  /// Mutex protecting the buffers and counters
+  mutable Mutex mBufferMutex;
+  /// Signaled when a buffer is queued
+  Condition mBufferQueued;
+  /// Descriptor of the open log file
+  int mFile;
+  /// Number of the open log file
+  size_t mOpenFileIdx;
+  /// Whether the open log file is written with O_DIRECT
+  bool mOpenDirectIO;
+  /// Index of the open log file
+  LogIndex mLogIndex;
+  /// Codec of compressed log files
+  PacketCodec mCodec;
+  /// Compressed buffer
+  std::vector<uint8_t> mCompressedData;
+  /// Mutex serializing the writes
+  Mutex mWriteMutex;
+  /** @}
+    */
+
+};
+
+#endif // PACKETLOGGER_H
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+#include "sensor/PoseInterpolator.h"
+
+#include <algorithm>
+
+#include "exceptions/BadArgumentException.h"
+#include "exceptions/OutOfBoundException.h"
+
+namespace {
+
+bool isEarlier(const PoseInterpolator::Container::value_type& a, int64_t
+    timestamp) {
+  return a.first < timestamp;
+}
+
+}
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+PoseInterpolator::PoseInterpolator(size_t capacity, int64_t
+    maxExtrapolation) :
+    mCapacity(capacity),
+    mMaxExtrapolation(maxExtrapolation) {
+}
+
+PoseInterpolator::PoseInterpolator(const PoseInterpolator& other) :
+    MotionModel() {
+  Mutex::ScopedLock lock(other.mMutex);
+  mPoses = other.mPoses;
+  mCapacity = other.mCapacity;
+  mMaxExtrapolation = other.mMaxExtrapolation;
+}
+
+PoseInterpolator& PoseInterpolator::operator = (const PoseInterpolator&
+    other) {
+  if (this != &other) {
+    Container poses;
+    size_t capacity;
+    int64_t maxExtrapolation;
+    {
+      Mutex::ScopedLock lock(other.mMutex);
+      poses = other.mPoses;
+      capacity = other.mCapacity;
+      maxExtrapolation = other.mMaxExtrapolation;
+    }
+    Mutex::ScopedLock lock(mMutex);
+    mPoses.swap(poses);
+    mCapacity = capacity;
+    mMaxExtrapolation = maxExtrapolation;
+  }
+  return *this;
+}
+
+PoseInterpolator::~PoseInterpolator() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+size_t PoseInterpolator::getCapacity() const {
+  Mutex::ScopedLock lock(mMutex);
+  return mCapacity;
+}
+
+void PoseInterpolator::setCapacity(size_t capacity) {
+  Mutex::ScopedLock lock(mMutex);
+  mCapacity = capacity;
+  while (mPoses.size() > mCapacity)
+    mPoses.pop_front();
+}
+
+int64_t PoseInterpolator::getMaxExtrapolation() const {
+  Mutex::ScopedLock lock(mMutex);
+  return mMaxExtrapolation;
+}
+
+void PoseInterpolator::setMaxExtrapolation(int64_t maxExtrapolation) {
+  Mutex::ScopedLock lock(mMutex);
+  mMaxExtrapolation = maxExtrapolation;
+}
+
+size_t PoseInterpolator::getSize() const {
+  Mutex::ScopedLock lock(mMutex);
+  return mPoses.size();
+}
+
+Pose PoseInterpolator::getPose(int64_t timestamp) const {
+  Mutex::ScopedLock lock(mMutex);
+  return lookupPose(timestamp);
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+Pose PoseInterpolator::lookupPose(int64_t timestamp) const {
+  if (mPoses.empty())
+    throw OutOfBoundException<int64_t>(timestamp,
+      "PoseInterpolator::getPose(): empty pose stream",
+      __FILE__, __LINE__);
+  if (timestamp <= mPoses.front().first)
+    return mPoses.front().second;
+  if (timestamp > mPoses.back().first) {
+    const Container::const_reverse_iterator last = mPoses.rbegin();
+    const Container::const_reverse_iterator prev = last + 1;
+    if (prev == mPoses.rend())
+      return last->second;
+    const int64_t extrapolation = std::min(timestamp - last->first,
+      std::max(mMaxExtrapolation, static_cast<int64_t>(0)));
+    return prev->second.interpolate(last->second,
+      static_cast<double>(last->first - prev->first + extrapolation) /
+      static_cast<double>(last->first - prev->first));
+  }
+  Container::const_iterator it = std::lower_bound(mPoses.begin(),
+    mPoses.end(), timestamp, isEarlier);
+  if (it->first == timestamp)
+    return it->second;
+  Container::const_iterator prev = it - 1;
+  return prev->second.interpolate(it->second,
+    static_cast<double>(timestamp - prev->first) /
+    static_cast<double>(it->first - prev->first));
+}
+
+void PoseInterpolator::addPose(int64_t timestamp, const Pose& pose) {
+  Mutex::ScopedLock lock(mMutex);
+  if (!mPoses.empty() && (timestamp <= mPoses.back().first))
+    throw BadArgumentException<int64_t>(timestamp,
+      "PoseInterpolator::addPose(): timestamps must be increasing",
+      __FILE__, __LINE__);
+  mPoses.push_back(std::make_pair(timestamp, pose));
+  while (mPoses.size() > mCapacity)
+    mPoses.pop_front();
+}
+
+void PoseInterpolator::clear() {
+  Mutex::ScopedLock lock(mMutex);
+  mPoses.clear();
+}
+
+Pose PoseInterpolator::getRelativePose(int64_t timestamp, int64_t reference)
+    const {
+  Mutex::ScopedLock lock(mMutex);
+  return lookupPose(reference).getInverse() * lookupPose(timestamp);
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file PoseInterpolator.h
+    \brief This file defines the PoseInterpolator class, which interpolates a
+           stream of timestamped sensor poses
+  */
+
+#ifndef POSEINTERPOLATOR_H
+#define POSEINTERPOLATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <deque>
+#include <utility>
+
+#include "base/Mutex.h"
+#include "sensor/MotionModel.h"
+
+/** The class PoseInterpolator interpolates a stream of timestamped sensor
+    poses, e.g., from an inertial navigation system. Poses are added in
+    increasing timestamp order, possibly from another thread than the one
+    querying them, and the oldest ones are dropped beyond the capacity.
+    Queries before the first pose return the first pose. Queries past the
+    last pose extrapolate the motion between the last two poses, as the pose
+    stream usually lags behind the sensor data, up to a maximum
+    extrapolation time beyond which the pose is held.
+    \brief Pose stream interpolator
+  */
+class PoseInterpolator :
+  public MotionModel {
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Container type
+  typedef std::deque<std::pair<int64_t, Pose> > Container;
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs the interpolator with a capacity and a maximum
+  /// extrapolation time [ns]
+  PoseInterpolator(size_t capacity = 1000, int64_t maxExtrapolation =
+    100000000);
+  /// Copy constructor
+  PoseInterpolator(const PoseInterpolator& other);
+  /// Assignment operator
+  PoseInterpolator& operator = (const PoseInterpolator& other);
+  /// Destructor
+  virtual ~PoseInterpolator();
+  /** @}
+    */
+
+  /** \name Accessors
+    @{
+    */
+  /// Returns the capacity
+  size_t getCapacity() const;
+  /// Sets the capacity
+  void setCapacity(size_t capacity);
+  /// Returns the maximum extrapolation time [ns]
+  int64_t getMaxExtrapolation() const;
+  /// Sets the maximum extrapolation time [ns]
+  void setMaxExtrapolation(int64_t maxExtrapolation);
+  /// Returns the number of poses
+  size_t getSize() const;
+  /// Returns the pose at a timestamp
+  Pose getPose(int64_t timestamp) const;
+  /** @}
+    */
+
+  /** \name Methods
+    @{
+    */
+  /// Adds a pose
+  void addPose(int64_t timestamp, const Pose& pose);
+  /// Removes all the poses
+  void clear();
+  /// Returns the sensor pose at a timestamp in the sensor frame at a reference
+  virtual Pose getRelativePose(int64_t timestamp, int64_t reference) const;
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Returns the pose at a timestamp, the mutex being held
+  Pose lookupPose(int64_t timestamp) const;
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Poses with their timestamps
+  Container mPoses;
+  /// Capacity
+  size_t mCapacity;
+  /// Maximum extrapolation time
+  int64_t mMaxExtrapolation;
+  /// Mutex protecting the poses
+  mutable Mutex mMutex;
+  /** @}
+    */
+
+};
+
+#endif // POSEINTERPOLATOR_H
@@ -18,8 +18,6 @@
 
 #include "sensor/PositionPacket.h"
 
-#include <chrono>
-
 #include "com/UDPConnectionServer.h"
 #include "base/BinaryBufferReader.h"
 #include "base/BinaryStreamReader.h"
@@ -195,15 +193,19 @@ void PositionPacket::writeRawPacket(BinaryWriter& stream) const {
 }
 
 void PositionPacket::readBinary(UDPConnectionServer& stream) {
-  stream.read(reinterpret_cast<char*>(mRawPacket), mPacketSize);
-  auto time = std::chrono::high_resolution_clock::now();
-  mTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-    time.time_since_epoch()).count();
+  stream.read(reinterpret_cast<char*>(mRawPacket), mPacketSize,
+    mTimestamp);
   BinaryBufferReader binaryStream(reinterpret_cast<char*>(mRawPacket),
     mPacketSize);
   readRawPacket(binaryStream);
 }
 
+void PositionPacket::readBinary(const char* buffer, int64_t timestamp) {
+  mTimestamp = timestamp;
+  BinaryBufferReader binaryStream(buffer, mPacketSize);
+  readRawPacket(binaryStream);
+}
+
 void PositionPacket::writeBinary(std::ostream& stream) const {
   BinaryStreamWriter<std::ostream> binaryStream(stream);
   binaryStream << mTimestamp;
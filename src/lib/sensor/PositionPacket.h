@@ -122,6 +122,8 @@ public:
     */
   /// Binary read from UDP
   void readBinary(UDPConnectionServer& stream);
+  /// Binary read from a raw buffer received at the given timestamp
+  void readBinary(const char* buffer, int64_t timestamp);
   /// Binary write into a output stream
   void writeBinary(std::ostream& stream) const;
   /// Binary read from an input stream
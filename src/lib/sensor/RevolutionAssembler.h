@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file RevolutionAssembler.h
+    \brief This file defines the RevolutionAssembler class, which assembles
+           Velodyne data packets into full revolutions.
+  */
+
+#ifndef REVOLUTIONASSEMBLER_H
+#define REVOLUTIONASSEMBLER_H
+
+#include <cstdint>
+
+#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/Calibration.h"
+#include "sensor/Converter.h"
+#include "sensor/SensorTraits.h"
+#include "sensor/MotionModel.h"
+#include "sensor/Deskewer.h"
+#include "data-structures/VdynePointCloud.h"
+#include "data-structures/VdynePointCloudSoA.h"
+#include "data-structures/VdyneScanCloud.h"
+
+/** The class RevolutionAssembler assembles Velodyne data packets into full
+    revolutions, either VdynePointCloud, VdynePointCloudSoA or
+    VdyneScanCloud. Revolutions are split exactly at a cut angle, at data
+    chunk level, so that the packet crossing the cut angle contributes to
+    both revolutions. The partial revolution before the first cut is
+    discarded. Two frames are swapped between revolutions, so that no
+    reallocation happens once warmed up. The sensor model S selects the
+    conversion specialized for the HDL-32E or the HDL-64E, by default the
+    model of the calibration. Packet timestamps come from the timestamp
+    source of the assembler, the host timestamps by default. With a motion
+    model, completed point cloud revolutions are deskewed to their timestamp.
+    \brief Velodyne revolution assembler
+  */
+template <typename C, typename S = AutoSensor> class RevolutionAssembler {
+  /** \name Private constructors
+    @{
+    */
+  /// Copy constructor
+  RevolutionAssembler(const RevolutionAssembler& other);
+  /// Assignment operator
+  RevolutionAssembler& operator = (const RevolutionAssembler& other);
+  /** @}
+    */
+
+public:
+  /** \name Types definitions
+    @{
+    */
+  /// Cloud type
+  typedef C Cloud;
+  /// Sensor model type
+  typedef S Sensor;
+  /** @}
+    */
+
+  /** \name Constructors/destructor
+    @{
+    */
+  /// Constructs assembler with calibration, cut angle and distance range
+  RevolutionAssembler(const Calibration& calibration, float cutAngle = 0.0,
+    float minDistance = Converter::mMinDistance, float maxDistance =
+    Converter::mMaxDistance);
+  /// Destructor
+  ~RevolutionAssembler();
+  /** @}
+    */
+
+  /** \name Accessors
+      @{
+    */
+  /// Returns the cut angle in radians
+  float getCutAngle() const;
+  /// Sets the cut angle in radians
+  void setCutAngle(float cutAngle);
+  /// Returns the minimum distance
+  float getMinDistance() const;
+  /// Sets the minimum distance
+  void setMinDistance(float minDistance);
+  /// Returns the maximum distance
+  float getMaxDistance() const;
+  /// Sets the maximum distance
+  void setMaxDistance(float maxDistance);
+  /// Returns the source of the packet timestamps
+  Converter::TimestampSource getTimestampSource() const;
+  /// Sets the source of the packet timestamps
+  void setTimestampSource(Converter::TimestampSource source);
+  /// Returns the motion model deskewing the revolutions, 0 if none
+  const MotionModel* getMotionModel() const;
+  /// Sets the motion model deskewing the revolutions, 0 for none
+  void setMotionModel(const MotionModel* model);
+  /// Returns the last complete revolution
+  const Cloud& getRevolution() const;
+  /// Returns the timestamp of the first packet of the last revolution
+  int64_t getStartTimestamp() const;
+  /// Returns the timestamp of the last packet of the last revolution
+  int64_t getEndTimestamp() const;
+  /// Returns the number of complete revolutions
+  size_t getNumRevolutions() const;
+  /** @}
+    */
+
+  /** \name Methods
+      @{
+    */
+  /// Adds a packet, returns true if a revolution was completed
+  template <typename P> bool addPacket(const P& dataPacket);
+  /// Completes the current revolution if not empty, e.g., at end of log
+  bool flush();
+  /// Discards the current revolution and waits for the next cut
+  void reset();
+  /** @}
+    */
+
+protected:
+  /** \name Protected methods
+    @{
+    */
+  /// Returns the rotational information of a data chunk
+  static uint16_t getRotationalInfo(const DataPacket& dataPacket, size_t
+    chunkIdx);
+  /// Returns the rotational information of a raw data chunk
+  static uint16_t getRotationalInfo(const DataPacketView& dataPacket, size_t
+    chunkIdx);
+  /// Converts a data chunk into a point cloud
+  template <typename P> void convert(const P& dataPacket, size_t chunkIdx,
+    VdynePointCloud& pointCloud) const;
+  /// Converts a data chunk into a SoA point cloud
+  template <typename P> void convert(const P& dataPacket, size_t chunkIdx,
+    VdynePointCloudSoA& pointCloud) const;
+  /// Converts a data chunk into a scan cloud
+  template <typename P> void convert(const P& dataPacket, size_t chunkIdx,
+    VdyneScanCloud& scanCloud) const;
+  /// Deskews a point cloud revolution
+  void deskew(VdynePointCloud& pointCloud);
+  /// Deskews a SoA point cloud revolution
+  void deskew(VdynePointCloudSoA& pointCloud);
+  /// Leaves a scan cloud revolution, which has no time offsets
+  void deskew(VdyneScanCloud& scanCloud);
+  /// Completes the current revolution and swaps the frames
+  void complete();
+  /** @}
+    */
+
+  /** \name Protected members
+    @{
+    */
+  /// Calibration
+  const Calibration& mCalibration;
+  /// Cut rotation in rotational units
+  uint16_t mCutRotation;
+  /// Minimum distance
+  float mMinDistance;
+  /// Maximum distance
+  float mMaxDistance;
+  /// Source of the packet timestamps
+  Converter::TimestampSource mTimestampSource;
+  /// Double-buffered frames
+  Cloud mFrames[2];
+  /// Index of the frame being assembled
+  size_t mCurrentFrame;
+  /// Start timestamps of the frames
+  int64_t mStartTimestamps[2];
+  /// End timestamps of the frames
+  int64_t mEndTimestamps[2];
+  /// Rotation of the last data chunk
+  uint16_t mLastRotation;
+  /// Whether a data chunk has been seen since the last reset
+  bool mHasLastRotation;
+  /// Whether the first cut has been seen since the last reset
+  bool mStarted;
+  /// Whether the current frame received data chunks
+  bool mHasData;
+  /// Number of complete revolutions
+  size_t mNumRevolutions;
+  /// Motion model deskewing the revolutions
+  const MotionModel* mMotionModel;
+  /// Deskewer of the revolutions
+  Deskewer mDeskewer;
+  /** @}
+    */
+
+};
+
+#include "sensor/RevolutionAssembler.tpp"
+
+#endif // REVOLUTIONASSEMBLER_H
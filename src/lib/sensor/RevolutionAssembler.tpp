@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/******************************************************************************/
+/* Constructors and Destructor                                                */
+/******************************************************************************/
+
+template <typename C, typename S>
+RevolutionAssembler<C, S>::RevolutionAssembler(const Calibration& calibration,
+    float cutAngle, float minDistance, float maxDistance) :
+    mCalibration(calibration),
+    mMinDistance(minDistance),
+    mMaxDistance(maxDistance),
+    mTimestampSource(Converter::host),
+    mCurrentFrame(0),
+    mNumRevolutions(0),
+    mMotionModel(0) {
+  setCutAngle(cutAngle);
+  mStartTimestamps[0] = mStartTimestamps[1] = 0;
+  mEndTimestamps[0] = mEndTimestamps[1] = 0;
+  reset();
+}
+
+template <typename C, typename S>
+RevolutionAssembler<C, S>::~RevolutionAssembler() {
+}
+
+/******************************************************************************/
+/* Accessors                                                                  */
+/******************************************************************************/
+
+template <typename C, typename S>
+float RevolutionAssembler<C, S>::getCutAngle() const {
+  return Calibration::deg2rad(static_cast<float>(mCutRotation) /
+    static_cast<float>(DataPacket::mRotationResolution));
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::setCutAngle(float cutAngle) {
+  mCutRotation = Converter::getCutRotation(cutAngle);
+}
+
+template <typename C, typename S>
+float RevolutionAssembler<C, S>::getMinDistance() const {
+  return mMinDistance;
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::setMinDistance(float minDistance) {
+  mMinDistance = minDistance;
+}
+
+template <typename C, typename S>
+float RevolutionAssembler<C, S>::getMaxDistance() const {
+  return mMaxDistance;
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::setMaxDistance(float maxDistance) {
+  mMaxDistance = maxDistance;
+}
+
+template <typename C, typename S>
+Converter::TimestampSource RevolutionAssembler<C, S>::getTimestampSource()
+    const {
+  return mTimestampSource;
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::setTimestampSource(Converter::TimestampSource
+    source) {
+  mTimestampSource = source;
+}
+
+template <typename C, typename S>
+const MotionModel* RevolutionAssembler<C, S>::getMotionModel() const {
+  return mMotionModel;
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::setMotionModel(const MotionModel* model) {
+  mMotionModel = model;
+}
+
+template <typename C, typename S>
+const typename RevolutionAssembler<C, S>::Cloud&
+    RevolutionAssembler<C, S>::getRevolution() const {
+  return mFrames[1 - mCurrentFrame];
+}
+
+template <typename C, typename S>
+int64_t RevolutionAssembler<C, S>::getStartTimestamp() const {
+  return mStartTimestamps[1 - mCurrentFrame];
+}
+
+template <typename C, typename S>
+int64_t RevolutionAssembler<C, S>::getEndTimestamp() const {
+  return mEndTimestamps[1 - mCurrentFrame];
+}
+
+template <typename C, typename S>
+size_t RevolutionAssembler<C, S>::getNumRevolutions() const {
+  return mNumRevolutions;
+}
+
+/******************************************************************************/
+/* Methods                                                                    */
+/******************************************************************************/
+
+template <typename C, typename S>
+uint16_t RevolutionAssembler<C, S>::getRotationalInfo(const DataPacket&
+    dataPacket, size_t chunkIdx) {
+  return dataPacket.getDataChunk(chunkIdx).mRotationalInfo;
+}
+
+template <typename C, typename S>
+uint16_t RevolutionAssembler<C, S>::getRotationalInfo(const DataPacketView&
+    dataPacket, size_t chunkIdx) {
+  return dataPacket.getRotationalInfo(chunkIdx);
+}
+
+template <typename C, typename S>
+template <typename P>
+void RevolutionAssembler<C, S>::convert(const P& dataPacket, size_t chunkIdx,
+    VdynePointCloud& pointCloud) const {
+  Converter::toPointCloud<S>(dataPacket, chunkIdx, mCalibration, pointCloud,
+    mMinDistance, mMaxDistance, mTimestampSource);
+}
+
+template <typename C, typename S>
+template <typename P>
+void RevolutionAssembler<C, S>::convert(const P& dataPacket, size_t chunkIdx,
+    VdynePointCloudSoA& pointCloud) const {
+  Converter::toPointCloud<S>(dataPacket, chunkIdx, mCalibration, pointCloud,
+    mMinDistance, mMaxDistance, mTimestampSource);
+}
+
+template <typename C, typename S>
+template <typename P>
+void RevolutionAssembler<C, S>::convert(const P& dataPacket, size_t chunkIdx,
+    VdyneScanCloud& scanCloud) const {
+  Converter::toScanCloud<S>(dataPacket, chunkIdx, mCalibration, scanCloud,
+    mMinDistance, mMaxDistance);
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::deskew(VdynePointCloud& pointCloud) {
+  mDeskewer.deskew(pointCloud, *mMotionModel);
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::deskew(VdynePointCloudSoA& pointCloud) {
+  mDeskewer.deskew(pointCloud, *mMotionModel);
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::deskew(VdyneScanCloud& /*scanCloud*/) {
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::complete() {
+  Cloud& frame = mFrames[mCurrentFrame];
+  frame.setEndRotationAngle(Calibration::deg2rad(
+    static_cast<float>(mLastRotation) /
+    static_cast<float>(DataPacket::mRotationResolution)));
+  mCurrentFrame = 1 - mCurrentFrame;
+  mFrames[mCurrentFrame].clear();
+  mHasData = false;
+  ++mNumRevolutions;
+  if (mMotionModel)
+    deskew(frame);
+}
+
+template <typename C, typename S>
+template <typename P>
+bool RevolutionAssembler<C, S>::addPacket(const P& dataPacket) {
+  bool completed = false;
+  for (size_t i = 0; i < DataPacket::mDataChunkNbr; ++i) {
+    const uint16_t rotation = getRotationalInfo(dataPacket, i);
+    if (Converter::crossesCut(rotation, mLastRotation, mHasLastRotation,
+        mCutRotation)) {
+      if (mStarted && mHasData) {
+        complete();
+        completed = true;
+      }
+      mStarted = true;
+    }
+    mLastRotation = rotation;
+    mHasLastRotation = true;
+    if (!mStarted)
+      continue;
+    Cloud& frame = mFrames[mCurrentFrame];
+    if (!mHasData) {
+      frame.setStartRotationAngle(Calibration::deg2rad(
+        static_cast<float>(rotation) /
+        static_cast<float>(DataPacket::mRotationResolution)));
+      mStartTimestamps[mCurrentFrame] = Converter::getTimestamp(dataPacket,
+        mTimestampSource);
+      frame.setTimestamp(mStartTimestamps[mCurrentFrame]);
+      mHasData = true;
+    }
+    mEndTimestamps[mCurrentFrame] = Converter::getTimestamp(dataPacket,
+      mTimestampSource);
+    convert(dataPacket, i, frame);
+  }
+  return completed;
+}
+
+template <typename C, typename S>
+bool RevolutionAssembler<C, S>::flush() {
+  if (!mHasData)
+    return false;
+  complete();
+  reset();
+  return true;
+}
+
+template <typename C, typename S>
+void RevolutionAssembler<C, S>::reset() {
+  mFrames[mCurrentFrame].clear();
+  mHasLastRotation = false;
+  mStarted = false;
+  mHasData = false;
+}
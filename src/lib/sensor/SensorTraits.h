@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (C) 2011 by Jerome Maye                                          *
+ * jerome.maye@gmail.com                                                      *
+ *                                                                            *
+ * This program is free software; you can redistribute it and/or modify       *
+ * it under the terms of the Lesser GNU General Public License as published by*
+ * the Free Software Foundation; either version 3 of the License, or          *
+ * (at your option) any later version.                                        *
+ *                                                                            *
+ * This program is distributed in the hope that it will be useful,            *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              *
+ * Lesser GNU General Public License for more details.                        *
+ *                                                                            *
+ * You should have received a copy of the Lesser GNU General Public License   *
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.       *
+ ******************************************************************************/
+
+/** \file SensorTraits.h
+    \brief This file defines the traits of the Velodyne sensor models.
+  */
+
+#ifndef SENSORTRAITS_H
+#define SENSORTRAITS_H
+
+#include <cstddef>
+
+#include "sensor/DataPacket.h"
+
+/** The struct HDL64E defines the traits of the Velodyne HDL-64E S2. Each
+    firing yields an upper and a lower bank data chunk, fired together, and
+    the lasers of a bank fire in sequence. The timing is approximate and
+    derived from the nominal rate of 3472 packets per second.
+    \brief Velodyne HDL-64E S2 traits
+  */
+struct HDL64E {
+  /// Number of lasers
+  static const size_t mNumLasers = 64;
+  /// Number of banks
+  static const size_t mNumBanks = 2;
+  /// Number of data chunks per firing
+  static const size_t mChunksPerFiring = 2;
+  /// Distance resolution
+  static const size_t mDistanceResolution = DataPacket::mDistanceResolution;
+  /// Duration of a firing in nanoseconds
+  static const size_t mFiringPeriod = 48000;
+  /// Delay between two lasers of a bank in nanoseconds
+  static const size_t mLaserPeriod = 1500;
+};
+
+/** The struct HDL32E defines the traits of the Velodyne HDL-32E. It only
+    uses the upper bank, every data chunk is a firing of the 32 lasers in
+    sequence.
+    \brief Velodyne HDL-32E traits
+  */
+struct HDL32E {
+  /// Number of lasers
+  static const size_t mNumLasers = 32;
+  /// Number of banks
+  static const size_t mNumBanks = 1;
+  /// Number of data chunks per firing
+  static const size_t mChunksPerFiring = 1;
+  /// Distance resolution
+  static const size_t mDistanceResolution = DataPacket::mDistanceResolution;
+  /// Duration of a firing in nanoseconds
+  static const size_t mFiringPeriod = 46080;
+  /// Delay between two lasers in nanoseconds
+  static const size_t mLaserPeriod = 1152;
+};
+
+/** The struct AutoSensor stands for the sensor model of the calibration,
+    picked at runtime by the conversions: the HDL-32E for a calibration of
+    32 lasers, the HDL-64E otherwise.
+    \brief Sensor model of the calibration
+  */
+struct AutoSensor {
+};
+
+#endif // SENSORTRAITS_H
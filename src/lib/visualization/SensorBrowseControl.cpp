@@ -20,8 +20,11 @@
 
 #include <QtCore/QDateTime>
 #include <QtGui/QFileDialog>
+#include <QtGui/QMessageBox>
 
 #include "sensor/Converter.h"
+#include "exceptions/IOException.h"
+#include "exceptions/SystemException.h"
 
 #include "ui_SensorBrowseControl.h"
 
@@ -31,10 +34,10 @@
 
 SensorBrowseControl::SensorBrowseControl(bool showPoints) :
     mUi(new Ui_SensorBrowseControl()),
-    mLogFilesize(0),
-    mLogFilepos(0),
+    mLogPacketIdx(0),
     mMinDistance(Converter::mMinDistance),
-    mMaxDistance(Converter::mMaxDistance) {
+    mMaxDistance(Converter::mMaxDistance),
+    mAssembler(mCalibration, 0.0, mMinDistance, mMaxDistance) {
   mUi->setupUi(this);
   mLogMenu = mMenu.addMenu("Log");
   mLogStartAction = mLogMenu->addAction("Seek start", this,
@@ -94,10 +97,8 @@ void SensorBrowseControl::setSmoothPoints(bool smoothPoints) {
 void SensorBrowseControl::setCalibrationFilename(const QString& filename) {
   mUi->calibrationEdit->setText(filename);
   const QFileInfo fileInfo(filename);
-  if (fileInfo.isFile() && fileInfo.isReadable()) {
-    std::ifstream calibFile(filename.toStdString());
-    calibFile >> mCalibration;
-  }
+  if (fileInfo.isFile() && fileInfo.isReadable())
+    mCalibration.load(filename.toStdString());
 }
 
 void SensorBrowseControl::setLogFilename(const QString& filename) {
@@ -107,22 +108,25 @@ void SensorBrowseControl::setLogFilename(const QString& filename) {
     open(filename.toAscii().constData());
   else
     close();
-  mUi->logStartButton->setEnabled(mLogFile.is_open());
-  mUi->logPlayButton->setEnabled(mLogFile.is_open());
-  mUi->logSkipButton->setEnabled(mLogFile.is_open());
-  mLogStartAction->setEnabled(mLogFile.is_open());
-  mLogPlayAction->setEnabled(mLogFile.is_open());
-  mLogSkipAction->setEnabled(mLogFile.is_open());
+  mUi->logStartButton->setEnabled(mLogReader.isOpen());
+  mUi->logPlayButton->setEnabled(mLogReader.isOpen());
+  mUi->logSkipButton->setEnabled(mLogReader.isOpen());
+  mLogStartAction->setEnabled(mLogReader.isOpen());
+  mLogPlayAction->setEnabled(mLogReader.isOpen());
+  mLogSkipAction->setEnabled(mLogReader.isOpen());
+  mUi->logSlider->setEnabled(mLogIndex.getNumRevolutions() > 0);
 }
 
 void SensorBrowseControl::setMinDistance(double minDistance) {
   mMinDistance = std::min(minDistance, mMaxDistance);
+  mAssembler.setMinDistance(mMinDistance);
   mUi->minDistanceSpinBox->setValue(mMinDistance);
 
 }
 
 void SensorBrowseControl::setMaxDistance(double maxDistance) {
   mMaxDistance = std::max(mMinDistance, maxDistance);
+  mAssembler.setMaxDistance(mMaxDistance);
   mUi->maxDistanceSpinBox->setValue(mMaxDistance);
 }
 
@@ -154,7 +158,7 @@ void SensorBrowseControl::renderPoints(double size, bool smooth) {
 void SensorBrowseControl::calibrationBrowseClicked() {
   const QString filename = QFileDialog::getOpenFileName(this,
     "Open Calibration File", mUi->calibrationEdit->text(),
-    "Velodyne calibration files (*.dat)");
+    "Velodyne calibration files (*.dat *.xml *.bin)");
   if (!filename.isNull())
     setCalibrationFilename(filename);
 }
@@ -175,6 +179,8 @@ void SensorBrowseControl::logPlayToggled() {
   mUi->logBrowseButton->setEnabled(!mUi->logPlayButton->isChecked());
   mLogStartAction->setEnabled(!mUi->logPlayButton->isChecked());
   mLogSkipAction->setEnabled(!mUi->logPlayButton->isChecked());
+  mUi->logSlider->setEnabled(!mUi->logPlayButton->isChecked() &&
+    mLogIndex.getNumRevolutions() > 0);
   mLogPlayAction->setChecked(mUi->logPlayButton->isChecked());
   if (mUi->logPlayButton->isChecked()) {
     mTimer.start(0);
@@ -199,6 +205,19 @@ void SensorBrowseControl::logSkipClicked() {
   readPointCloud();
 }
 
+void SensorBrowseControl::logSliderReleased() {
+  if (!mLogIndex.getNumRevolutions())
+    return;
+  const int64_t startTimestamp = mLogIndex.getRevolution(0).mTimestamp;
+  const int64_t endTimestamp =
+    mLogIndex.getRevolution(mLogIndex.getNumRevolutions() - 1).mTimestamp;
+  const double progress = (double)(mUi->logSlider->sliderPosition() -
+    mUi->logSlider->minimum()) / (mUi->logSlider->maximum() -
+    mUi->logSlider->minimum());
+  if (seek(startTimestamp + (endTimestamp - startTimestamp) * progress))
+    readPointCloud();
+}
+
 void SensorBrowseControl::timerTimeout() {
   if (readPointCloud())
     mTimer.start(0);
@@ -236,78 +255,112 @@ void SensorBrowseControl::render(View3d& /*view*/, Scene3d& /*Scene3d*/) {
 }
 
 double SensorBrowseControl::getProgress() const {
-  if (mLogFilesize)
-    return (double)mLogFilepos / mLogFilesize;
+  if (mLogReader.getNumPackets())
+    return (double)mLogPacketIdx / mLogReader.getNumPackets();
   else
     return 0.0;
 }
 
 bool SensorBrowseControl::open(const char* filename) {
   close();
-  mLogFile.open(filename, std::ios::in | std::ios::binary);
-  if (mLogFile.is_open()) {
-    mLogFile.seekg(0, std::ios_base::end);
-    mLogFilesize = mLogFile.tellg();
-    mLogFile.seekg(0, std::ios_base::beg);
-    mLogFilepos = 0;
-    return true;
+  try {
+    mLogReader.open(filename);
   }
-  else
+  catch (const SystemException& /*exception*/) {
     return false;
+  }
+  catch (const IOException& exception) {
+    QMessageBox::warning(this, "Log File Error", exception.what());
+    return false;
+  }
+  const std::string indexFilename = LogIndex::getFilename(filename);
+  try {
+    mLogIndex.read(indexFilename);
+  }
+  catch (const IOException& /*exception*/) {
+    mLogIndex.clear();
+  }
+  if (mLogIndex.getNumPackets() != mLogReader.getNumPackets()) {
+    try {
+      mLogIndex.build(mLogReader);
+    }
+    catch (const IOException& exception) {
+      mLogIndex.clear();
+      QMessageBox::warning(this, "Log File Error", exception.what());
+      return mLogReader.isOpen();
+    }
+    try {
+      mLogIndex.open(indexFilename);
+      mLogIndex.close();
+    }
+    catch (const IOException& /*exception*/) {
+    }
+  }
+  return mLogReader.isOpen();
 }
 
 void SensorBrowseControl::close() {
-  if (mLogFile.is_open())
-    mLogFile.close();
-  mLogFilesize = 0;
-  mLogFilepos = 0;
+  mLogReader.close();
+  mLogIndex.clear();
+  mLogPacketIdx = 0;
+  mAssembler.reset();
 }
 
 bool SensorBrowseControl::rewind() {
-  if (mLogFile.is_open()) {
-    mLogFile.clear();
-    mLogFile.seekg(0, std::ios::beg);
+  if (mLogReader.isOpen()) {
+    mLogPacketIdx = 0;
+    mAssembler.reset();
     return true;
   }
   else
     return false;
 }
 
-bool SensorBrowseControl::readPacket(DataPacket& packet) {
-  if (mLogFile.is_open() && !mLogFile.eof()) {
-    packet.readBinary(mLogFile);
-    mLogFilepos = mLogFile.tellg();
+bool SensorBrowseControl::seek(int64_t timestamp) {
+  if (!mLogReader.isOpen() || !mLogIndex.getNumRevolutions())
+    return false;
+  const size_t packetIdx = mLogIndex.getRevolution(
+    mLogIndex.findRevolution(timestamp)).mPacketIdx;
+  mLogPacketIdx = packetIdx ? packetIdx - 1 : 0;
+  mAssembler.reset();
+  return true;
+}
+
+bool SensorBrowseControl::readPacket(DataPacketView& packet) {
+  if (mLogPacketIdx < mLogReader.getNumPackets()) {
+    packet = mLogReader.getPacket(mLogPacketIdx++);
     return true;
   }
-  else {
-    mLogFilepos = mLogFilesize;
+  else
     return false;
-  }
 }
 
 bool SensorBrowseControl::readPointCloud() {
-  if (mLogFile.is_open() && !mLogFile.eof()) {
-    mPointCloud.clear();
-    DataPacket packet;
-    size_t numPackets = 0;
-    double startAngle;
+  if (mLogPacketIdx < mLogReader.getNumPackets()) {
+    mLogReader.willNeed(mLogPacketIdx, mReadAhead);
+    DataPacketView packet(0);
     bool finished = false;
-    while (1) {
-      if (readPacket(packet)) {
-        Converter::toPointCloud(packet, mCalibration, mPointCloud, mMinDistance,
-          mMaxDistance);
-        if (numPackets && (startAngle > mPointCloud.getEndRotationAngle()))
+    try {
+      while (1) {
+        if (readPacket(packet)) {
+          if (mAssembler.addPacket(packet))
+            break;
+        }
+        else {
+          mAssembler.flush();
+          mUi->logPlayButton->toggle();
+          finished = true;
           break;
-        else
-          startAngle = mPointCloud.getStartRotationAngle();
-        ++numPackets;
+        }
       }
-      else {
+    }
+    catch (const IOException& exception) {
+      if (mUi->logPlayButton->isChecked())
         mUi->logPlayButton->toggle();
-        finished = true;
-        break;
-      }
+      QMessageBox::warning(this, "Log File Error", exception.what());
+      return false;
     }
+    mPointCloud = mAssembler.getRevolution();
     mUi->logSlider->setSliderPosition(mUi->logSlider->minimum() +
       (mUi->logSlider->maximum() - mUi->logSlider->minimum()) *
       getProgress());
@@ -34,7 +34,10 @@
 #include "visualization/Scene3d.h"
 #include "base/Singleton.h"
 #include "sensor/Calibration.h"
-#include "sensor/DataPacket.h"
+#include "sensor/DataPacketView.h"
+#include "sensor/PacketLogReader.h"
+#include "sensor/LogIndex.h"
+#include "sensor/RevolutionAssembler.h"
 #include "data-structures/VdynePointCloud.h"
 
 class Ui_SensorBrowseControl;
@@ -104,15 +107,25 @@ protected:
   void close();
   /// Rewind log file
   bool rewind();
+  /// Seek the revolution in progress at a timestamp
+  bool seek(int64_t timestamp);
   /// Get progress of log file
   double getProgress() const;
   /// Read packet from log file
-  bool readPacket(DataPacket& packet);
+  bool readPacket(DataPacketView& packet);
   /// Read point cloud
   bool readPointCloud();
   /** @}
     */
 
+  /** \name Protected static members
+    @{
+    */
+  /// Number of packets prefetched ahead of a revolution
+  static const size_t mReadAhead = 1024;
+  /** @}
+    */
+
   /** \name Protected members
     @{
     */
@@ -132,18 +145,21 @@ protected:
   QTimer mTimer;
   /// Velodyne calibration
   Calibration mCalibration;
-  /// Log file
-  std::ifstream mLogFile;
-  /// Log file size
-  size_t mLogFilesize;
-  /// Log file position
-  size_t mLogFilepos;
+  /// Log file reader
+  PacketLogReader mLogReader;
+  /// Index of the next packet in the log file
+  size_t mLogPacketIdx;
+  /// Revolution index of the log file
+  LogIndex mLogIndex;
   /// Min distance of the points
   double mMinDistance;
   /// Max distance of the points
   double mMaxDistance;
   /// Velodyne point cloud
   VdynePointCloud mPointCloud;
+  /// Revolution assembler, following the sensor model of the loaded
+  /// calibration
+  RevolutionAssembler<VdynePointCloud> mAssembler;
   /** @}
     */
 
@@ -163,6 +179,8 @@ protected slots:
   void logStartClicked();
   /// Log skip clicked
   void logSkipClicked();
+  /// Log slider released
+  void logSliderReleased();
   /// Timeout of the timer
   void timerTimeout();
   /// Color changed
@@ -34,6 +34,7 @@ SensorLiveControl::SensorLiveControl(
     mUi(new Ui_SensorLiveControl()),
     mMinDistance(Converter::mMinDistance),
     mMaxDistance(Converter::mMaxDistance),
+    mAssembler(mCalibration, 0.0, mMinDistance, mMaxDistance),
     mAcqBuffer(acqBuffer) {
   mUi->setupUi(this);
   mTimer.setSingleShot(true);
@@ -83,20 +84,20 @@ void SensorLiveControl::setSmoothPoints(bool smoothPoints) {
 void SensorLiveControl::setCalibrationFilename(const QString& filename) {
   mUi->calibrationEdit->setText(filename);
   const QFileInfo fileInfo(filename);
-  if (fileInfo.isFile() && fileInfo.isReadable()) {
-    std::ifstream calibFile(filename.toStdString());
-    calibFile >> mCalibration;
-  }
+  if (fileInfo.isFile() && fileInfo.isReadable())
+    mCalibration.load(filename.toStdString());
 }
 
 void SensorLiveControl::setMinDistance(double minDistance) {
   mMinDistance = std::min(minDistance, mMaxDistance);
+  mAssembler.setMinDistance(mMinDistance);
   mUi->minDistanceSpinBox->setValue(mMinDistance);
 
 }
 
 void SensorLiveControl::setMaxDistance(double maxDistance) {
   mMaxDistance = std::max(mMinDistance, maxDistance);
+  mAssembler.setMaxDistance(mMaxDistance);
   mUi->maxDistanceSpinBox->setValue(mMaxDistance);
 }
 
@@ -128,14 +129,14 @@ void SensorLiveControl::renderPoints(double size, bool smooth) {
 void SensorLiveControl::calibrationBrowseClicked() {
   const QString filename = QFileDialog::getOpenFileName(this,
     "Open Calibration File", mUi->calibrationEdit->text(),
-    "Velodyne calibration files (*.dat)");
+    "Velodyne calibration files (*.dat *.xml *.bin)");
   if (!filename.isNull())
     setCalibrationFilename(filename);
 }
 
 void SensorLiveControl::timerTimeout() {
   if (readPointCloud()) {
-    mPointCloud = mAcqPointCloud;
+    mPointCloud = mAssembler.getRevolution();
     View3d::getInstance().update();
     mTimer.start(0);
     emit start();
@@ -178,40 +179,28 @@ void SensorLiveControl::render(View3d& /*view*/, Scene3d& /*Scene3d*/) {
 }
 
 bool SensorLiveControl::readPacket(std::shared_ptr<DataPacket>& packet) {
-  if (mAcqBuffer.isEmpty())
-    return false;
-  else {
-    packet = mAcqBuffer.dequeue();
-    return true;
-  }
+  return mAcqBuffer.dequeue(packet, 0.01);
 }
 
 bool SensorLiveControl::readPointCloud() {
-  mAcqPointCloud.clear();
   std::shared_ptr<DataPacket> packet;
-  size_t numPackets = 0;
-  double startAngle;
   while (1) {
     if (readPacket(packet)) {
-      Converter::toPointCloud(*packet, mCalibration, mAcqPointCloud,
-        mMinDistance, mMaxDistance);
-      if (numPackets && (startAngle > mAcqPointCloud.getEndRotationAngle()))
+      if (mAssembler.addPacket(*packet))
         break;
-      else
-        startAngle = mAcqPointCloud.getStartRotationAngle();
-      ++numPackets;
     }
     else
       QApplication::processEvents();
   }
-  if (mAcqPointCloud.getSize()) {
-    const double timestamp = mAcqPointCloud.getTimestamp();
+  const VdynePointCloud& pointCloud = mAssembler.getRevolution();
+  if (pointCloud.getSize()) {
+    const double timestamp = pointCloud.getTimestamp();
     const QDateTime time = QDateTime::fromTime_t(timestamp);
     QString msecs;
     msecs.sprintf("%03d", (uint)((timestamp - (size_t)timestamp) * 1e3));
     mUi->timestampLabel->setText(
         time.toString("yyyy-MM-dd hh:mm:ss:" + msecs));
   }
-  mUi->numPointsSpinBox->setValue(mAcqPointCloud.getSize());
+  mUi->numPointsSpinBox->setValue(pointCloud.getSize());
   return true;
 }
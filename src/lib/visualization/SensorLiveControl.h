@@ -36,6 +36,7 @@
 #include "sensor/Calibration.h"
 #include "sensor/DataPacket.h"
 #include "sensor/AcquisitionThread.h"
+#include "sensor/RevolutionAssembler.h"
 #include "data-structures/VdynePointCloud.h"
 
 class Ui_SensorLiveControl;
@@ -122,8 +123,9 @@ protected:
   double mMaxDistance;
   /// Velodyne point cloud used for display
   VdynePointCloud mPointCloud;
-  /// Velodyne point cloud used for acquiring
-  VdynePointCloud mAcqPointCloud;
+  /// Revolution assembler used for acquiring, following the sensor model of
+  /// the loaded calibration
+  RevolutionAssembler<VdynePointCloud> mAssembler;
   /// Acquisition thread
   AcquisitionThread<DataPacket>::Buffer& mAcqBuffer;
   /** @}